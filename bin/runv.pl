@@ -298,7 +298,8 @@ sub c_build
   &myprint("Object files to link:");
   &myprint(@object_files);
 
-  my $vpi_cmd = "iverilog-vpi @object_files";
+  # The worker pool (WorkerPool.h) runs on std::thread.
+  my $vpi_cmd = "iverilog-vpi @object_files -lpthread";
   &myprint("vpi command:");
   &myprint($vpi_cmd);
   &nl();
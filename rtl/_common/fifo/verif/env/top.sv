@@ -36,11 +36,6 @@ module top();
       clks0.start();
       $display("Finished gen clocks at %t", $time);
     end
-    begin
-      #10000ns;
-      $display("Test finished at %t", $time);
-      $finish;
-    end
     join
     init_done = '1;
   end
@@ -0,0 +1,314 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   BitVectorBench.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Stand-alone microbenchmark for the BitVector class.
+#                     Sweeps the common operations across a set of widths in
+#                     both 2-state and 4-state modes and reports the average
+#                     time per operation as CSV (default) or JSON.
+#
+#                     Usage:
+#                       bitvector_bench [-fmt csv|json] [-o <file>]
+#                                       [-min_ms <ms>] [-log <file>]
+#
+#                     Build and run from verif/ with 'make bench'.
+#
+###############################################################################
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BitVector.h"
+#include "Common.h"
+#include "Logger.h"
+
+using namespace std;
+
+class BitVectorBench
+{
+  // Nested Classes
+  private:
+  struct Result
+  {
+    string    op;
+    UInt32    width;
+    NB_STATES states;
+    UInt64    iterations;
+    double    nsPerOp;
+  };
+
+  // Constants
+  private:
+    const vector<UInt32> c_widths = { 1, 8, 32, 64, 65, 128, 512, 4096 };
+
+  // Private Members
+  private:
+    double          m_minMs;
+    vector<Result>  m_results;
+    volatile UInt64 m_sink;     // Keeps the compiler from dropping the work.
+
+  // Constructors
+  public:
+    BitVectorBench(double iMinMs) : m_minMs(iMinMs), m_sink(0) { }
+
+  // Public Methods
+  public:
+    void Run();
+    void WriteCsv(ostream & oStream) const;
+    void WriteJson(ostream & oStream) const;
+
+  // Private Methods
+  private:
+    void runWidth(UInt32 iWidth, NB_STATES iStates);
+    void fill(BitVector & ioBv, UInt32 iSeed) const;
+    template<typename Fn>
+    void timeOp(const string & iOp, UInt32 iWidth, NB_STATES iStates, Fn iFn);
+    static string statesName(NB_STATES iStates);
+};
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+void BitVectorBench::Run()
+{
+  for(UInt32 ii=0; ii<c_widths.size(); ii++)
+  {
+    runWidth(c_widths[ii], NB_STATES::TWO_STATE);
+    runWidth(c_widths[ii], NB_STATES::FOUR_STATE);
+  }
+}
+void BitVectorBench::WriteCsv(ostream & oStream) const
+{
+  oStream << "op,width,states,iterations,ns_per_op" << endl;
+  for(UInt32 ii=0; ii<m_results.size(); ii++)
+  {
+    const Result & l_r = m_results[ii];
+    oStream << l_r.op << "," << l_r.width << "," << statesName(l_r.states) << ","
+            << l_r.iterations << "," << l_r.nsPerOp << endl;
+  }
+}
+void BitVectorBench::WriteJson(ostream & oStream) const
+{
+  oStream << "[" << endl;
+  for(UInt32 ii=0; ii<m_results.size(); ii++)
+  {
+    const Result & l_r = m_results[ii];
+    oStream << "  {\"op\": \"" << l_r.op << "\", \"width\": " << l_r.width
+            << ", \"states\": \"" << statesName(l_r.states) << "\""
+            << ", \"iterations\": " << l_r.iterations
+            << ", \"ns_per_op\": " << l_r.nsPerOp << "}"
+            << ((ii + 1 < m_results.size()) ? "," : "") << endl;
+  }
+  oStream << "]" << endl;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+void BitVectorBench::runWidth(UInt32 iWidth, NB_STATES iStates)
+{
+  BitVector l_a("bench_a", iWidth, iStates);
+  BitVector l_b("bench_b", iWidth, iStates);
+  fill(l_a, 0x9e3779b9);
+  fill(l_b, 0x7f4a7c15);
+
+  // Part select of up to 16 bits starting a quarter of the way in.
+  UInt32 l_lo = iWidth / 4;
+  UInt32 l_hi = (l_lo + 15 < iWidth) ? l_lo + 15 : iWidth - 1;
+
+  timeOp("construct", iWidth, iStates, [&]() {
+    BitVector l_bv("bench", iWidth, iStates);
+    return l_bv[0];
+  });
+  timeOp("copy", iWidth, iStates, [&]() {
+    BitVector l_bv(l_a);
+    return l_bv[0];
+  });
+  // Includes the copy needed to produce a fresh source; subtract 'copy'.
+  timeOp("copy_move", iWidth, iStates, [&]() {
+    BitVector l_tmp(l_a);
+    BitVector l_bv(move(l_tmp));
+    return l_bv[0];
+  });
+  timeOp("add", iWidth, iStates, [&]() {
+    BitVector l_bv = l_a + l_b;
+    return l_bv[0];
+  });
+  // The mutating ops work on their own copy, l_a stays a fixed input.
+  BitVector l_acc(l_a);
+  timeOp("add_assign_u32", iWidth, iStates, [&]() {
+    l_acc += 0x1234567u;
+    return l_acc[0];
+  });
+  timeOp("sub", iWidth, iStates, [&]() {
+    BitVector l_bv = l_a - l_b;
+    return l_bv[0];
+  });
+  timeOp("shift_left", iWidth, iStates, [&]() {
+    BitVector l_bv = l_a << 3;
+    return l_bv[0];
+  });
+  timeOp("shift_right", iWidth, iStates, [&]() {
+    BitVector l_bv = l_a >> 3;
+    return l_bv[0];
+  });
+  timeOp("partselect_get", iWidth, iStates, [&]() {
+    BitVector l_bv(l_a(l_hi, l_lo));
+    return l_bv[0];
+  });
+  BitVector l_dst(l_a);
+  timeOp("partselect_set", iWidth, iStates, [&]() {
+    l_dst(l_hi, l_lo) = 0xa5a5u;
+    return l_dst[0];
+  });
+  timeOp("tostring_hex", iWidth, iStates, [&]() {
+    l_a.PrintFmt_set(BitVector::PRINT_FMT::HEX);
+    return (UInt32)l_a.ToString().size();
+  });
+  timeOp("tostring_dec", iWidth, iStates, [&]() {
+    l_a.PrintFmt_set(BitVector::PRINT_FMT::DEC);
+    return (UInt32)l_a.ToString().size();
+  });
+  timeOp("equal", iWidth, iStates, [&]() {
+    return (UInt32)(l_a == l_b);
+  });
+  timeOp("less_than", iWidth, iStates, [&]() {
+    return (UInt32)(l_a < l_b);
+  });
+}
+void BitVectorBench::fill(BitVector & ioBv, UInt32 iSeed) const
+{
+  // Simple LCG pattern so every word carries non-zero data.
+  UInt32 l_val = iSeed;
+  for(UInt32 ii=0; ii<ioBv.Size_get(); ii+=32)
+  {
+    l_val = l_val * 1664525u + 1013904223u;
+    UInt32 l_hi = (ii + 31 < ioBv.Size_get()) ? ii + 31 : ioBv.Size_get() - 1;
+    ioBv(l_hi, ii) = l_val;
+  }
+}
+template<typename Fn>
+void BitVectorBench::timeOp(const string & iOp, UInt32 iWidth, NB_STATES iStates, Fn iFn)
+{
+  typedef chrono::steady_clock Clock;
+  // Double the batch size until a single batch runs for at least m_minMs.
+  UInt64 l_iters = 1;
+  double l_ns = 0;
+  while(true)
+  {
+    UInt64 l_sink = 0;
+    Clock::time_point l_start = Clock::now();
+    for(UInt64 ii=0; ii<l_iters; ii++)
+    {
+      l_sink += iFn();
+    }
+    Clock::time_point l_end = Clock::now();
+    // One volatile store per batch, out of the timed loop.
+    m_sink = m_sink + l_sink;
+    l_ns = chrono::duration<double, nano>(l_end - l_start).count();
+    if((l_ns >= m_minMs * 1e6) || (l_iters >= (1ULL << 40)))
+    {
+      break;
+    }
+    l_iters <<= 1;
+  }
+
+  Result l_r;
+  l_r.op = iOp;
+  l_r.width = iWidth;
+  l_r.states = iStates;
+  l_r.iterations = l_iters;
+  l_r.nsPerOp = l_ns / l_iters;
+  m_results.push_back(l_r);
+}
+string BitVectorBench::statesName(NB_STATES iStates)
+{
+  return (iStates == NB_STATES::TWO_STATE) ? "2state" : "4state";
+}
+
+// =============================
+// ===**       Main        **===
+// =============================
+int main(int argc, char ** argv)
+{
+  string l_fmt = "csv";
+  string l_outFile = "";
+  string l_logFile = "bitvector_bench.log";
+  double l_minMs = 20;
+
+  string l_usage = string("Usage: ") + argv[0] + " [-fmt csv|json] [-o <file>] [-min_ms <ms>] [-log <file>]";
+  for(Int32 ii=1; ii<argc; ii++)
+  {
+    string l_arg = argv[ii];
+    if((l_arg == "-fmt") && (ii + 1 < argc))
+    {
+      l_fmt = argv[++ii];
+      if((l_fmt != "csv") && (l_fmt != "json"))
+      {
+        cerr << "Unknown format '" << l_fmt << "'." << endl;
+        cerr << l_usage << endl;
+        return 1;
+      }
+    }
+    else if((l_arg == "-o") && (ii + 1 < argc))
+    {
+      l_outFile = argv[++ii];
+    }
+    else if((l_arg == "-min_ms") && (ii + 1 < argc))
+    {
+      l_minMs = atof(argv[++ii]);
+    }
+    else if((l_arg == "-log") && (ii + 1 < argc))
+    {
+      l_logFile = argv[++ii];
+    }
+    else
+    {
+      cerr << "Unknown argument '" << l_arg << "'." << endl;
+      cerr << l_usage << endl;
+      return 1;
+    }
+  }
+
+  // BitVector logs through DOUT, so one must exist. Keep it quiet and off stdout.
+  Logger l_logger(l_logFile, &cerr, Logger::Scope::Vrb_NONE());
+  l_logger.SetAsDout();
+
+  BitVectorBench l_bench(l_minMs);
+  l_bench.Run();
+
+  ofstream l_file;
+  ostream * l_out = &cout;
+  if(l_outFile != "")
+  {
+    l_file.open(l_outFile, ios::out | ios::trunc);
+    if(!l_file.is_open())
+    {
+      cerr << "Could not open output file '" << l_outFile << "'." << endl;
+      return 1;
+    }
+    l_out = &l_file;
+  }
+  if(l_fmt == "json")
+  {
+    l_bench.WriteJson(*l_out);
+  }
+  else
+  {
+    l_bench.WriteCsv(*l_out);
+  }
+  return 0;
+}
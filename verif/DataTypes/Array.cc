@@ -0,0 +1,397 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Array.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "hierarchy.h"
+#include "Logger.h"
+#include "Manip.h"
+#include "vpi_entry.h"
+
+#include "Array.h"
+
+using namespace Text;
+
+// =============================
+// ===**   Constructors    **===
+// =============================
+Array::Array(string iFullName, NB_STATES iStates)
+{
+  m_nbStates = iStates;
+  if(!init(iFullName))
+  {
+    LOG_ERR_ENV << "Could not initialize the array '" << iFullName << "'." << endl;
+    return;
+  }
+}
+
+// =============================
+// ===**      Inits        **===
+// =============================
+bool Array::init(string iFullName)
+{
+  m_nameFull = iFullName;
+  m_arrHandle = NULL;
+  m_depth = 0;
+  m_width = 0;
+  m_lowIndex = 0;
+  vector<string> l_layers = Manip::Split(iFullName, '.');
+  if(l_layers.size() > 0)
+  {
+    // Take the last element as the name.
+    m_name = l_layers[l_layers.size() - 1];
+  }
+  else
+  {
+    m_name = m_nameFull;
+  }
+
+  m_arrHandle = Hierarchy::Find(m_nameFull);
+  if(m_arrHandle == NULL)
+  {
+    m_arrHandle = Vpi::vpi_handle_by_name(m_nameFull.c_str(), vpi_entry::TopModule_get());
+  }
+  if(m_arrHandle == NULL)
+  {
+    LOG_WRN_ENV << "Could not find array '" << m_nameFull << "'" << endl;
+    return false;
+  }
+  Vpi::OBJECT l_type = Pli::GetType(m_arrHandle);
+  if((l_type != Vpi::OBJECT::REG_ARRAY) && (l_type != Vpi::OBJECT::NET_ARRAY) && (l_type != Vpi::OBJECT::MEMORY))
+  {
+    LOG_ERR_ENV << "Object " << m_nameFull << " type (" << (Int32)l_type
+                << ") is not an array/memory." << endl;
+    m_arrHandle = NULL;
+    return false;
+  }
+
+  m_depth = Pli::GetSize(m_arrHandle);
+  vpiHandle l_left = Vpi::vpi_handle(Vpi::OBJECT::LEFT_RANGE, m_arrHandle);
+  vpiHandle l_right = Vpi::vpi_handle(Vpi::OBJECT::RIGHT_RANGE, m_arrHandle);
+  if((l_left != NULL) && (l_right != NULL))
+  {
+    Int32 l_l = Pli::GetInt(l_left);
+    Int32 l_r = Pli::GetInt(l_right);
+    m_lowIndex = (l_l < l_r) ? l_l : l_r;
+  }
+
+  m_elems.assign(m_depth, NULL);
+  if(!select(m_lowIndex))
+  {
+    return false;
+  }
+  m_width = Pli::GetSize(m_xport.hndl);
+  return Pli::InitVectorContext(m_xport.hndl, m_width, m_xport);
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+BitVector Array::Get(Int32 iIndex)
+{
+  BitVector l_retVal(m_nameFull + "[" + to_string(iIndex) + "]", m_width, m_nbStates);
+  if(!checkRange(iIndex, 1) || !select(iIndex))
+  {
+    return l_retVal;
+  }
+  Pli::GetVector(m_xport, l_retVal.m_aval, l_retVal.m_bval);
+  return l_retVal;
+}
+void Array::Set(Int32 iIndex, const BitVector & iValue)
+{
+  if(!checkRange(iIndex, 1) || !select(iIndex))
+  {
+    return;
+  }
+  // Size it to the element so narrower values clear the upper words.
+  BitVector l_val(m_nameFull, m_width, m_nbStates);
+  l_val = iValue;
+  if((l_val.m_bval != nullptr) && (iValue.m_bval != nullptr))
+  {
+    for(UInt32 kk=0; (kk<l_val.m_bval->size()) && (kk<iValue.m_bval->size()); kk++)
+    {
+      (*l_val.m_bval)[kk] = (*iValue.m_bval)[kk];
+    }
+  }
+  Pli::SetVector(m_xport, l_val.m_aval, l_val.m_bval);
+}
+void Array::Set(Int32 iIndex, UInt64 iValue)
+{
+  if(!checkRange(iIndex, 1) || !select(iIndex))
+  {
+    return;
+  }
+  BitVector l_val(m_nameFull, m_width, m_nbStates);
+  l_val = iValue;
+  Pli::SetVector(m_xport, l_val.m_aval, l_val.m_bval);
+}
+bool Array::Read(Int32 iFirst, UInt32 iCount, vector<UInt32> & oAval, vector<UInt32> * oBval)
+{
+  if(!checkRange(iFirst, iCount))
+  {
+    return false;
+  }
+  UInt32 l_words = Get_Words();
+  oAval.resize(iCount * l_words);
+  if(oBval != nullptr)
+  {
+    oBval->resize(iCount * l_words);
+  }
+  for(UInt32 ii=0; ii<iCount; ii++)
+  {
+    if(!select(iFirst + ii))
+    {
+      return false;
+    }
+    Pli::GetVectorWords(m_xport, &oAval[ii * l_words], (oBval != nullptr) ? &(*oBval)[ii * l_words] : nullptr);
+  }
+  return true;
+}
+bool Array::Write(Int32 iFirst, UInt32 iCount, const vector<UInt32> & iAval, const vector<UInt32> * iBval)
+{
+  if(!checkRange(iFirst, iCount))
+  {
+    return false;
+  }
+  UInt32 l_words = Get_Words();
+  if((iAval.size() < iCount * l_words) || ((iBval != nullptr) && (iBval->size() < iCount * l_words)))
+  {
+    LOG_ERR_ENV << "Buffer for '" << m_nameFull << "' holds fewer than " << iCount
+                << " elements of " << l_words << " words." << endl;
+    return false;
+  }
+  for(UInt32 ii=0; ii<iCount; ii++)
+  {
+    if(!select(iFirst + ii))
+    {
+      return false;
+    }
+    Pli::SetVectorWords(m_xport, &iAval[ii * l_words], (iBval != nullptr) ? &(*iBval)[ii * l_words] : nullptr);
+  }
+  return true;
+}
+bool Array::Fill(UInt64 iValue)
+{
+  BitVector l_val(m_nameFull, m_width, NB_STATES::TWO_STATE);
+  l_val = iValue;
+  for(UInt32 ii=0; ii<m_depth; ii++)
+  {
+    if(!select(m_lowIndex + ii))
+    {
+      return false;
+    }
+    Pli::SetVectorWords(m_xport, l_val.m_aval->data());
+  }
+  return true;
+}
+bool Array::LoadHex(string iFileName, Int32 iFirst)
+{
+  ifstream l_file(iFileName);
+  if(!l_file.is_open())
+  {
+    LOG_ERR_ENV << "Could not open hex file '" << iFileName << "'." << endl;
+    return false;
+  }
+
+  UInt32 l_words = Get_Words();
+  vector<UInt32> l_aval(l_words, 0);
+  vector<UInt32> l_bval(l_words, 0);
+  Int32 l_index = iFirst;
+  UInt32 l_loaded = 0;
+  UInt32 l_lineNb = 0;
+  string l_line;
+  while(getline(l_file, l_line))
+  {
+    l_lineNb++;
+    size_t l_comment = l_line.find("//");
+    if(l_comment != string::npos)
+    {
+      l_line.erase(l_comment);
+    }
+    stringstream l_tokens(l_line);
+    string l_token;
+    while(l_tokens >> l_token)
+    {
+      if(l_token[0] == '@')
+      {
+        l_index = (Int32)strtol(l_token.c_str() + 1, nullptr, 16);
+        continue;
+      }
+      if(!parseHexWord(l_token, l_aval.data(), l_bval.data()))
+      {
+        LOG_ERR_ENV << iFileName << ":" << l_lineNb << ": '" << l_token << "' is not a hex value." << endl;
+        return false;
+      }
+      if(!checkRange(l_index, 1) || !select(l_index))
+      {
+        return false;
+      }
+      Pli::SetVectorWords(m_xport, l_aval.data(), (m_nbStates == NB_STATES::FOUR_STATE) ? l_bval.data() : nullptr);
+      l_index++;
+      l_loaded++;
+    }
+  }
+  LOG_DEBUG << "Loaded " << l_loaded << " words from '" << iFileName << "' into " << m_nameFull << endl;
+  return true;
+}
+bool Array::DumpHex(string iFileName, Int32 iFirst, UInt32 iCount)
+{
+  vector<UInt32> l_aval;
+  vector<UInt32> l_bval;
+  if(!Read(iFirst, iCount, l_aval, (m_nbStates == NB_STATES::FOUR_STATE) ? &l_bval : nullptr))
+  {
+    return false;
+  }
+  ofstream l_file(iFileName, ios::out | ios::trunc);
+  if(!l_file.is_open())
+  {
+    LOG_ERR_ENV << "Could not open hex file '" << iFileName << "' for writing." << endl;
+    return false;
+  }
+
+  UInt32 l_words = Get_Words();
+  l_file << "// " << m_nameFull << " [" << iFirst << ":" << (iFirst + (Int32)iCount - 1) << "]" << endl;
+  l_file << "@" << hex << iFirst << dec << endl;
+  for(UInt32 ii=0; ii<iCount; ii++)
+  {
+    l_file << formatHexWord(&l_aval[ii * l_words], l_bval.empty() ? nullptr : &l_bval[ii * l_words]) << endl;
+  }
+  return true;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool Array::checkRange(Int32 iFirst, UInt32 iCount) const
+{
+  if(m_arrHandle == NULL)
+  {
+    LOG_ERR_ENV << "Array '" << m_nameFull << "' is not bound." << endl;
+    return false;
+  }
+  if((iFirst < m_lowIndex) || ((Int64)iFirst + iCount - 1 > (Int64)Get_HighIndex()))
+  {
+    LOG_ERR_ENV << "Range [" << iFirst << " +" << iCount << "] is outside of '" << m_nameFull
+                << "' [" << m_lowIndex << ":" << Get_HighIndex() << "]." << endl;
+    return false;
+  }
+  return true;
+}
+bool Array::select(Int32 iIndex)
+{
+  UInt32 l_offset = iIndex - m_lowIndex;
+  if(m_elems[l_offset] == NULL)
+  {
+    m_elems[l_offset] = Vpi::vpi_handle_by_index(m_arrHandle, iIndex);
+    if(m_elems[l_offset] == NULL)
+    {
+      LOG_ERR_ENV << "Could not get element " << iIndex << " of '" << m_nameFull << "'." << endl;
+      return false;
+    }
+  }
+  m_xport.hndl = m_elems[l_offset];
+  return true;
+}
+bool Array::parseHexWord(const string & iToken, UInt32 * oAval, UInt32 * oBval) const
+{
+  UInt32 l_words = Get_Words();
+  for(UInt32 ii=0; ii<l_words; ii++)
+  {
+    oAval[ii] = 0;
+    oBval[ii] = 0;
+  }
+  // Rightmost digit is the least significant nibble.
+  UInt32 l_bit = 0;
+  for(Int32 ii=(Int32)iToken.size()-1; ii>=0; ii--)
+  {
+    char l_c = iToken[ii];
+    UInt32 l_a = 0;
+    UInt32 l_b = 0;
+    if(l_c == '_')
+    {
+      continue;
+    }
+    else if((l_c >= '0') && (l_c <= '9'))
+    {
+      l_a = l_c - '0';
+    }
+    else if((l_c >= 'a') && (l_c <= 'f'))
+    {
+      l_a = l_c - 'a' + 10;
+    }
+    else if((l_c >= 'A') && (l_c <= 'F'))
+    {
+      l_a = l_c - 'A' + 10;
+    }
+    else if((l_c == 'x') || (l_c == 'X'))
+    {
+      l_a = 0xf;
+      l_b = 0xf;
+    }
+    else if((l_c == 'z') || (l_c == 'Z') || (l_c == '?'))
+    {
+      l_b = 0xf;
+    }
+    else
+    {
+      return false;
+    }
+    if(l_bit < l_words * 32)
+    {
+      oAval[l_bit / 32] |= l_a << (l_bit % 32);
+      oBval[l_bit / 32] |= l_b << (l_bit % 32);
+    }
+    l_bit += 4;
+  }
+  // Drop anything above the element width.
+  if(m_width % 32 != 0)
+  {
+    UInt32 l_mask = (1u << (m_width % 32)) - 1;
+    oAval[l_words - 1] &= l_mask;
+    oBval[l_words - 1] &= l_mask;
+  }
+  return true;
+}
+string Array::formatHexWord(const UInt32 * iAval, const UInt32 * iBval) const
+{
+  const char * c_digits = "0123456789abcdef";
+  UInt32 l_nbDigits = (m_width + 3) / 4;
+  string l_retVal(l_nbDigits, '0');
+  for(UInt32 ii=0; ii<l_nbDigits; ii++)
+  {
+    UInt32 l_bit = ii * 4;
+    UInt32 l_a = (iAval[l_bit / 32] >> (l_bit % 32)) & 0xf;
+    UInt32 l_b = (iBval != nullptr) ? (iBval[l_bit / 32] >> (l_bit % 32)) & 0xf : 0;
+    char l_c;
+    if(l_b == 0)
+    {
+      l_c = c_digits[l_a];
+    }
+    else if(l_a == 0)
+    {
+      l_c = 'z';
+    }
+    else
+    {
+      l_c = 'x';
+    }
+    l_retVal[l_nbDigits - 1 - ii] = l_c;
+  }
+  return l_retVal;
+}
+
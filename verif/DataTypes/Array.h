@@ -0,0 +1,94 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Array.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Backdoor access to an rtl memory (reg/net array).
+#                     Element handles come from vpi_handle_by_index on first
+#                     use and are kept, and one transport context is shared
+#                     by all elements (they are all the same width).
+#                     Indexes are the rtl indexes (i.e. mem[0:DEPTH-1]).
+#
+#                     Bulk buffers are packed Get_Words() words per element:
+#                       element ii of a Read is at oAval[ii * Get_Words()].
+#
+#                     Hex files follow $readmemh: whitespace separated words,
+#                     '@<hex addr>' moves the address, '//' comments, and
+#                     x/z digits for 4-state arrays.
+#
+###############################################################################
+*/
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include <string>
+#include <vector>
+
+#include "BitVector.h"
+#include "Common.h"
+#include "pli.h"
+#include "vpi.h"
+
+using namespace std;
+
+class Array
+{
+  // Private Members
+  private:
+    string              m_name;
+    string              m_nameFull;
+    vpiHandle           m_arrHandle;
+    NB_STATES           m_nbStates;
+    UInt32              m_depth;
+    UInt32              m_width;
+    Int32               m_lowIndex;
+    vector<vpiHandle>   m_elems;    // Cached element handles, NULL until first use.
+    Pli::VectorContext  m_xport;    // Re-pointed at each element on access.
+
+  // Public Properties
+  public:
+    string      Get_Name() const      { return m_name; }
+    string      Get_NameFull() const  { return m_nameFull; }
+    UInt32      Get_Depth() const     { return m_depth; }
+    UInt32      Get_Width() const     { return m_width; }
+    UInt32      Get_Words() const     { return (m_width - 1) / 32 + 1; }
+    Int32       Get_LowIndex() const  { return m_lowIndex; }
+    Int32       Get_HighIndex() const { return m_lowIndex + (Int32)m_depth - 1; }
+
+  // Constructors
+  public:
+    Array(string iFullName, NB_STATES iStates = NB_STATES::FOUR_STATE);
+
+  // Inits
+  private:
+    bool init(string iFullName);
+
+  // Public Methods
+  public:
+    BitVector Get(Int32 iIndex);
+    void      Set(Int32 iIndex, const BitVector & iValue);
+    void      Set(Int32 iIndex, UInt64 iValue);
+    bool      Read(Int32 iFirst, UInt32 iCount, vector<UInt32> & oAval, vector<UInt32> * oBval = nullptr);
+    bool      Write(Int32 iFirst, UInt32 iCount, const vector<UInt32> & iAval, const vector<UInt32> * iBval = nullptr);
+    bool      Fill(UInt64 iValue);
+    bool      LoadHex(string iFileName, Int32 iFirst);
+    bool      LoadHex(string iFileName)   { return LoadHex(iFileName, m_lowIndex); }
+    bool      DumpHex(string iFileName, Int32 iFirst, UInt32 iCount);
+    bool      DumpHex(string iFileName)   { return DumpHex(iFileName, m_lowIndex, m_depth); }
+
+  // Private Methods
+  private:
+    bool      checkRange(Int32 iFirst, UInt32 iCount) const;
+    bool      select(Int32 iIndex);
+    bool      parseHexWord(const string & iToken, UInt32 * oAval, UInt32 * oBval) const;
+    string    formatHexWord(const UInt32 * iAval, const UInt32 * iBval) const;
+};
+
+#endif /* ARRAY_H */
+
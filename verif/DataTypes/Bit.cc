@@ -36,9 +36,14 @@ Bit::Bit(string iFullName)
   : TypeBase(iFullName, NB_STATES::TWO_STATE)
 {
   // Set the bitvector size based on the type and/or size of the verilog object.
+  // A signal that is already bound with the same size shares that binding's
+  // (read) mirror.
   set_Size();
-  createBV();
-  get_RtlValue();
+  if(!get_Shared())
+  {
+    createBV();
+    get_RtlValue();
+  }
 }
 
 // =============================
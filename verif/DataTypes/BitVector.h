@@ -61,6 +61,9 @@ class BitVector {
   friend class Bit;
   friend class Logic;
   friend class Integer;
+  friend class SignalBundle;
+  friend class Array;
+  friend class Tick;
 
   // Enums
   public:
@@ -0,0 +1,315 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Clock.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+
+#include "hierarchy.h"
+#include "Logger.h"
+#include "pli.h"
+#include "vpi_entry.h"
+
+#include "Clock.h"
+
+// ====================================
+// ===**  Private Static Members  **===
+// ====================================
+vector<Clock *> Clock::s_clocks;
+
+// =============================
+// ===**   Constructors    **===
+// =============================
+Clock::Clock(string iName, vpiHandle iHandle)
+{
+  m_name = iName;
+  m_handle = iHandle;
+  m_callBack = NULL;
+  m_last = Pli::GetScalar(iHandle);
+  m_dispatching = false;
+  m_nextId = 1;
+  for(UInt32 ii=0; ii<2; ii++)
+  {
+    m_edges[ii].count = 0;
+  }
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+Clock * Clock::Get(string iName)
+{
+  for(UInt32 ii=0; ii<s_clocks.size(); ii++)
+  {
+    if(s_clocks[ii]->m_name == iName)
+    {
+      return s_clocks[ii];
+    }
+  }
+
+  vpiHandle l_clk = Hierarchy::Find(iName);
+  if(l_clk == NULL)
+  {
+    l_clk = Vpi::vpi_handle_by_name(iName.c_str(), vpi_entry::TopModule_get());
+  }
+  if(l_clk == NULL)
+  {
+    LOG_ERR_ENV << "Could not find clock '" << iName << "'" << endl;
+    return nullptr;
+  }
+  Clock * l_clock = new Clock(iName, l_clk);
+  if(!l_clock->registerCB())
+  {
+    delete l_clock;
+    return nullptr;
+  }
+  s_clocks.push_back(l_clock);
+  return l_clock;
+}
+Clock::Id Clock::Subscribe(function<void()> iFn, Int32 iPriority, Vpi::EDGE iEdge)
+{
+  if((iEdge != Vpi::EDGE::POSEDGE) && (iEdge != Vpi::EDGE::NEGEDGE) && (iEdge != Vpi::EDGE::ANY_EDGE))
+  {
+    LOG_ERR_ENV << "Clock '" << m_name << "': subscriptions are on POSEDGE, NEGEDGE or ANY_EDGE." << endl;
+    return 0;
+  }
+  Subscriber l_sub;
+  l_sub.priority = iPriority;
+  l_sub.id = m_nextId++;
+  l_sub.fn = iFn;
+  l_sub.active = true;
+  for(UInt32 ii=0; ii<2; ii++)
+  {
+    if((ii == 0) ? (iEdge == Vpi::EDGE::NEGEDGE) : (iEdge == Vpi::EDGE::POSEDGE))
+    {
+      continue;
+    }
+    Edge & l_edge = m_edges[ii];
+    if(m_dispatching)
+    {
+      // Merged in once the edge is done, it starts with the next one.
+      l_edge.added.push_back(l_sub);
+      continue;
+    }
+    // Ids grow, so the new subscriber goes after every one of its priority.
+    auto l_pos = upper_bound(l_edge.every.begin(), l_edge.every.end(), l_sub,
+                             [](const Subscriber & iA, const Subscriber & iB)
+                             { return before(iA.priority, iA.id, iB.priority, iB.id); });
+    l_edge.every.insert(l_pos, l_sub);
+  }
+  return l_sub.id;
+}
+Clock::Id Clock::WaitCycles(UInt32 iCycles, function<void()> iFn, Int32 iPriority, Vpi::EDGE iEdge)
+{
+  if((iEdge != Vpi::EDGE::POSEDGE) && (iEdge != Vpi::EDGE::NEGEDGE))
+  {
+    LOG_ERR_ENV << "Clock '" << m_name << "': waits are on POSEDGE or NEGEDGE." << endl;
+    return 0;
+  }
+  if(iCycles == 0)
+  {
+    LOG_ERR_ENV << "Clock '" << m_name << "': can't wait for 0 cycles." << endl;
+    return 0;
+  }
+  Edge & l_edge = m_edges[(iEdge == Vpi::EDGE::POSEDGE) ? 0 : 1];
+  Waiter l_waiter;
+  l_waiter.due = l_edge.count + iCycles;
+  l_waiter.priority = iPriority;
+  l_waiter.id = m_nextId++;
+  l_waiter.fn = iFn;
+  l_edge.waiters.push_back(l_waiter);
+  push_heap(l_edge.waiters.begin(), l_edge.waiters.end(), laterWaiter);
+  return l_waiter.id;
+}
+bool Clock::Cancel(Id iId)
+{
+  bool l_found = false;
+  for(UInt32 ii=0; ii<2; ii++)
+  {
+    Edge & l_edge = m_edges[ii];
+    vector<Subscriber> * l_lists[2] = { &l_edge.every, &l_edge.added };
+    for(UInt32 kk=0; kk<2; kk++)
+    {
+      for(UInt32 jj=0; jj<l_lists[kk]->size(); jj++)
+      {
+        Subscriber & l_sub = (*l_lists[kk])[jj];
+        if((l_sub.id == iId) && l_sub.active)
+        {
+          // Not erased, the edge may be iterating the list (or running it).
+          l_sub.active = false;
+          l_found = true;
+        }
+      }
+    }
+    for(UInt32 jj=0; jj<l_edge.waiters.size(); jj++)
+    {
+      if((l_edge.waiters[jj].id == iId) && l_edge.waiters[jj].fn)
+      {
+        l_edge.waiters[jj].fn = nullptr;
+        l_found = true;
+      }
+    }
+  }
+  for(UInt32 jj=0; jj<m_due.size(); jj++)
+  {
+    if((m_due[jj].id == iId) && m_due[jj].fn)
+    {
+      m_due[jj].fn = nullptr;
+      l_found = true;
+    }
+  }
+  if(l_found && !m_dispatching)
+  {
+    compact(m_edges[0]);
+    compact(m_edges[1]);
+  }
+  return l_found;
+}
+void Clock::Transition(Vpi::SCALAR_VAL & ioLast, Vpi::SCALAR_VAL iVal, bool & oRise, bool & oFall)
+{
+  oRise = (iVal == Vpi::SCALAR_VAL::ONE) && (ioLast != Vpi::SCALAR_VAL::ONE);
+  oFall = (iVal == Vpi::SCALAR_VAL::ZERO) && (ioLast != Vpi::SCALAR_VAL::ZERO);
+  ioLast = iVal;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool Clock::registerCB()
+{
+  Vpi::t_cb_data l_cb_data;
+  Vpi::t_vpi_time l_vpi_time;
+  Vpi::t_vpi_value l_vpi_value;
+
+  l_vpi_time.type = Vpi::TIME_TYPE::SUPPRESS_TIME;
+  l_vpi_value.format = Vpi::VALUE_FORMAT::SCALAR;
+
+  l_cb_data.reason = Vpi::CB_REASON::VALUE_CHANGE;
+  l_cb_data.cb_rtn = s_edgeCB;
+  l_cb_data.obj = m_handle;
+  l_cb_data.time = &l_vpi_time;
+  l_cb_data.value = &l_vpi_value;
+  l_cb_data.index = 0;
+  l_cb_data.user_data = (char *)this;
+
+  m_callBack = Vpi::vpi_register_cb(&l_cb_data);
+  if(m_callBack == NULL)
+  {
+    LOG_ERR_ENV << "Could not register the edge callback on clock '" << m_name << "'" << endl;
+    return false;
+  }
+  return true;
+}
+void Clock::dispatch(UInt32 iEdge)
+{
+  Edge & l_edge = m_edges[iEdge];
+  l_edge.count++;
+  if(m_dispatching)
+  {
+    // The clock was driven from one of its own subscribers.
+    LOG_ERR_ENV << "Clock '" << m_name << "' changed while its edge was being dispatched." << endl;
+    return;
+  }
+  m_dispatching = true;
+
+  // Every edge takes all of its due waiters, so they all share the same due
+  // and come off the heap already in (priority, id) order.
+  while(!l_edge.waiters.empty() && (l_edge.waiters.front().due <= l_edge.count))
+  {
+    pop_heap(l_edge.waiters.begin(), l_edge.waiters.end(), laterWaiter);
+    m_due.push_back(l_edge.waiters.back());
+    l_edge.waiters.pop_back();
+  }
+
+  // Both lists are sorted, merge them as they run.
+  UInt32 ii = 0;
+  UInt32 kk = 0;
+  while((ii < l_edge.every.size()) || (kk < m_due.size()))
+  {
+    bool l_sub = (kk == m_due.size()) ||
+                 ((ii < l_edge.every.size()) &&
+                  before(l_edge.every[ii].priority, l_edge.every[ii].id, m_due[kk].priority, m_due[kk].id));
+    if(l_sub)
+    {
+      if(l_edge.every[ii].active)
+      {
+        l_edge.every[ii].fn();
+      }
+      ii++;
+    }
+    else
+    {
+      if(m_due[kk].fn)
+      {
+        // Moved out, the waiter may cancel itself (or capture its own owner).
+        function<void()> l_fn;
+        l_fn.swap(m_due[kk].fn);
+        l_fn();
+      }
+      kk++;
+    }
+  }
+  m_due.clear();
+  m_dispatching = false;
+  compact(m_edges[0]);
+  compact(m_edges[1]);
+}
+void Clock::compact(Edge & ioEdge)
+{
+  ioEdge.every.erase(remove_if(ioEdge.every.begin(), ioEdge.every.end(),
+                               [](const Subscriber & iSub) { return !iSub.active; }),
+                     ioEdge.every.end());
+  for(UInt32 ii=0; ii<ioEdge.added.size(); ii++)
+  {
+    if(!ioEdge.added[ii].active)
+    {
+      continue;
+    }
+    // Added after everything already there, the ids keep the order.
+    auto l_pos = upper_bound(ioEdge.every.begin(), ioEdge.every.end(), ioEdge.added[ii],
+                             [](const Subscriber & iA, const Subscriber & iB)
+                             { return before(iA.priority, iA.id, iB.priority, iB.id); });
+    ioEdge.every.insert(l_pos, ioEdge.added[ii]);
+  }
+  ioEdge.added.clear();
+  // Cancelled waiters stay in the heap until they come due.
+}
+bool Clock::before(Int32 iPrioA, Id iIdA, Int32 iPrioB, Id iIdB)
+{
+  return (iPrioA < iPrioB) || ((iPrioA == iPrioB) && (iIdA < iIdB));
+}
+bool Clock::laterWaiter(const Waiter & iA, const Waiter & iB)
+{
+  if(iA.due != iB.due)
+  {
+    return iA.due > iB.due;
+  }
+  return before(iB.priority, iB.id, iA.priority, iA.id);
+}
+Int32 Clock::s_edgeCB(Vpi::t_cb_data * iData)
+{
+  Clock * l_inst = (Clock *)iData->user_data;
+  bool l_rise;
+  bool l_fall;
+  Transition(l_inst->m_last, iData->value->value.scalar, l_rise, l_fall);
+  if(l_rise)
+  {
+    l_inst->dispatch(0);
+  }
+  else if(l_fall)
+  {
+    l_inst->dispatch(1);
+  }
+  return 0;
+}
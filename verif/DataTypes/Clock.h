@@ -0,0 +1,128 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Clock.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   One clock net, shared by everything keyed off its edges:
+#                       Clock * l_clk = Clock::Get("top.dut0.clk_w");
+#                       l_clk->Subscribe([&]() { m_drv.Cycle(); }, 10);
+#                       l_clk->WaitCycles(4, [&]() { ... });
+#                       UInt64 l_cycle = l_clk->Cycle_get();
+#
+#                     Get() returns the same Clock for the same name, and a
+#                     Clock registers a single value change callback on its
+#                     net, whatever the number of subscribers. Cycle_get()
+#                     counts rising edges.
+#                     On an edge, the per-cycle subscribers and the waiters
+#                     due on it run in one pass, by priority (lowest first),
+#                     then in registration order. Library samplers run at
+#                     c_samplePriority, before any user code, so they see the
+#                     pre-edge values of flops clocked by the same edge.
+#
+###############################################################################
+*/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "vpi.h"
+
+using namespace std;
+
+class Clock
+{
+  // Constants
+  public:
+  static const Int32  c_samplePriority = -1000000;
+  static const Int32  c_defaultPriority = 0;
+
+  // Nested Classes
+  public:
+  typedef UInt64 Id;
+
+  private:
+  struct Subscriber
+  {
+    Int32             priority;
+    Id                id;
+    function<void()>  fn;
+    bool              active;   // False once cancelled, dropped after the edge.
+  };
+  struct Waiter
+  {
+    UInt64            due;      // Edge count it runs on.
+    Int32             priority;
+    Id                id;
+    function<void()>  fn;       // Empty once cancelled.
+  };
+  // Subscribers and waiters of one edge (rising or falling).
+  struct Edge
+  {
+    UInt64              count;
+    vector<Subscriber>  every;    // Sorted by (priority, id).
+    vector<Subscriber>  added;    // Subscribed while dispatching.
+    vector<Waiter>      waiters;  // Min heap on (due, priority, id).
+  };
+
+  // Private Members
+  private:
+  string                  m_name;
+  vpiHandle               m_handle;
+  vpiHandle               m_callBack;
+  Vpi::SCALAR_VAL         m_last;
+  Edge                    m_edges[2];
+  vector<Waiter>          m_due;
+  bool                    m_dispatching;
+  Id                      m_nextId;
+  static vector<Clock *>  s_clocks;
+
+  // Public Properties
+  public:
+  string      Name_get() const          { return m_name; }
+  vpiHandle   Handle_get() const        { return m_handle; }
+  UInt64      Cycle_get() const         { return m_edges[0].count; }
+  UInt64      FallCount_get() const     { return m_edges[1].count; }
+
+  // Constructors
+  private:
+  Clock(string iName, vpiHandle iHandle);
+  Clock(const Clock &) = delete;
+  void operator=(const Clock &) = delete;
+
+  // Public Methods
+  public:
+  // nullptr (and an error) if the net doesn't exist.
+  static Clock *  Get(string iName);
+  // iFn runs on every iEdge (POSEDGE, NEGEDGE or ANY_EDGE) until cancelled.
+  Id              Subscribe(function<void()> iFn, Int32 iPriority = c_defaultPriority,
+                            Vpi::EDGE iEdge = Vpi::EDGE::POSEDGE);
+  // iFn runs once, on the iCycles-th iEdge (POSEDGE or NEGEDGE) from now.
+  Id              WaitCycles(UInt32 iCycles, function<void()> iFn, Int32 iPriority = c_defaultPriority,
+                             Vpi::EDGE iEdge = Vpi::EDGE::POSEDGE);
+  // False if the id already ran (one shot) or was cancelled.
+  bool            Cancel(Id iId);
+  // Edge detection on a scalar: a rise is a change to 1 (from 0, x or z),
+  // a fall a change to 0. Updates ioLast.
+  static void     Transition(Vpi::SCALAR_VAL & ioLast, Vpi::SCALAR_VAL iVal, bool & oRise, bool & oFall);
+
+  // Private Methods
+  private:
+  bool            registerCB();
+  void            dispatch(UInt32 iEdge);
+  void            compact(Edge & ioEdge);
+  static bool     before(Int32 iPrioA, Id iIdA, Int32 iPrioB, Id iIdB);
+  static bool     laterWaiter(const Waiter & iA, const Waiter & iB);
+  static Int32    s_edgeCB(Vpi::t_cb_data * iData);
+};
+
+#endif /* CLOCK_H */
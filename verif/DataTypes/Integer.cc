@@ -35,9 +35,14 @@
 Integer::Integer(string iFullName)
   : TypeBase(iFullName, NB_STATES::FOUR_STATE)
 {
+  // A signal that is already bound with the same size shares that binding's
+  // (read) mirror.
   set_Size();
-  createBV();
-  get_RtlValue();
+  if(!get_Shared())
+  {
+    createBV();
+    get_RtlValue();
+  }
 }
 
 // =============================
@@ -57,13 +62,13 @@ Integer::Integer(string iFullName)
 // =============================
 void Integer::set_Size()
 {
-  // TBD - Get the size based on the verilog object.
   Vpi::OBJECT l_type = Pli::GetType(get_SigHandle());
   if(l_type != Vpi::OBJECT::INTEGER_VAR)
   {
     LOG_WRN_ENV << "Object " << Get_NameFull() << " type (" << (Int32)l_type
-                << ") was not the expected type for a logic object." << endl;
+                << ") was not the expected type for an integer object." << endl;
   }
+  // An integer variable is always 32 bits.
   TypeBase::set_Size(32);
 }
 
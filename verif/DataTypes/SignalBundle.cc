@@ -0,0 +1,251 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   SignalBundle.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+
+#include "Logger.h"
+#include "pli.h"
+
+#include "SignalBundle.h"
+
+// =============================
+// ===**   Constructors    **===
+// =============================
+SignalBundle::SignalBundle(string iName)
+{
+  m_name = iName;
+  m_snapCount = 0;
+  m_clock = nullptr;
+  m_clkSub = 0;
+}
+SignalBundle::~SignalBundle()
+{
+  StopSampling();
+  Discard();
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+UInt32 SignalBundle::Add(TypeBase & iSig)
+{
+  Member l_mbr;
+  l_mbr.sig = &iSig;
+  l_mbr.size = iSig.Get_Size();
+  l_mbr.offset = m_aval.size();
+  l_mbr.nbWords = (l_mbr.size == 0) ? 1 : (l_mbr.size - 1) / 32 + 1;
+  l_mbr.staged = nullptr;
+  m_members.push_back(l_mbr);
+
+  m_aval.resize(m_aval.size() + l_mbr.nbWords, 0);
+  m_bval.resize(m_bval.size() + l_mbr.nbWords, 0);
+  return m_members.size() - 1;
+}
+Int32 SignalBundle::IndexOf(const string & iName) const
+{
+  for(UInt32 ii=0; ii<m_members.size(); ii++)
+  {
+    if((m_members[ii].sig->Get_Name() == iName) || (m_members[ii].sig->Get_NameFull() == iName))
+    {
+      return ii;
+    }
+  }
+  return -1;
+}
+void SignalBundle::Snapshot()
+{
+  // All members are read back to back from one callback (or call),
+  // so they all reflect the same point in the same timestep.
+  for(UInt32 ii=0; ii<m_members.size(); ii++)
+  {
+    Member & l_mbr = m_members[ii];
+    // A pending deferred write is newer than the rtl value.
+    if(!l_mbr.sig->Get_Dirty())
+    {
+      l_mbr.sig->get_RtlValue();
+    }
+    BitVector & l_bv = l_mbr.sig->get_BitVector();
+    for(UInt32 kk=0; kk<l_mbr.nbWords; kk++)
+    {
+      m_aval[l_mbr.offset + kk] = (*l_bv.m_aval)[kk];
+      m_bval[l_mbr.offset + kk] = (l_bv.m_bval != nullptr) ? (*l_bv.m_bval)[kk] : 0;
+    }
+  }
+  m_snapCount++;
+}
+bool SignalBundle::SampleOn(string iClockName, Vpi::EDGE iEdge)
+{
+  if((iEdge != Vpi::EDGE::POSEDGE) && (iEdge != Vpi::EDGE::NEGEDGE) && (iEdge != Vpi::EDGE::ANY_EDGE))
+  {
+    LOG_ERR_ENV << "Bundle '" << m_name << "': sampling edge must be POSEDGE, NEGEDGE or ANY_EDGE." << endl;
+    return false;
+  }
+  Clock * l_clock = Clock::Get(iClockName);
+  if(l_clock == nullptr)
+  {
+    LOG_ERR_ENV << "Bundle '" << m_name << "': could not sample on clock '" << iClockName << "'" << endl;
+    return false;
+  }
+  StopSampling();
+  m_clock = l_clock;
+  m_clkSub = l_clock->Subscribe([this]()
+                                {
+                                  Snapshot();
+                                  _Sampled();
+                                }, Clock::c_samplePriority, iEdge);
+  return m_clkSub != 0;
+}
+void SignalBundle::StopSampling()
+{
+  if(m_clock == nullptr)
+  {
+    return;
+  }
+  m_clock->Cancel(m_clkSub);
+  m_clock = nullptr;
+  m_clkSub = 0;
+}
+BitVector SignalBundle::Get(UInt32 iIdx) const
+{
+  if(!checkIndex(iIdx))
+  {
+    return BitVector(m_name, 1);
+  }
+  const Member & l_mbr = m_members[iIdx];
+  bool l_fourState = (l_mbr.sig->get_BitVector().m_bval != nullptr);
+  BitVector l_retVal(l_mbr.sig->Get_NameFull(), l_mbr.size,
+                     l_fourState ? NB_STATES::FOUR_STATE : NB_STATES::TWO_STATE);
+  for(UInt32 kk=0; kk<l_mbr.nbWords; kk++)
+  {
+    (*l_retVal.m_aval)[kk] = m_aval[l_mbr.offset + kk];
+    if(l_retVal.m_bval != nullptr)
+    {
+      (*l_retVal.m_bval)[kk] = m_bval[l_mbr.offset + kk];
+    }
+  }
+  return l_retVal;
+}
+UInt32 SignalBundle::GetWord(UInt32 iIdx, UInt32 iWord) const
+{
+  if(!checkIndex(iIdx))
+  {
+    return 0;
+  }
+  if(iWord >= m_members[iIdx].nbWords)
+  {
+    LOG_ERR_ENV << "Bundle '" << m_name << "': word " << iWord << " is out of range for member "
+                << iIdx << " (" << m_members[iIdx].nbWords << " words)." << endl;
+    return 0;
+  }
+  return m_aval[m_members[iIdx].offset + iWord];
+}
+void SignalBundle::Set(UInt32 iIdx, const BitVector & iValue)
+{
+  BitVector * l_bv = stage(iIdx);
+  if(l_bv == nullptr)
+  {
+    return;
+  }
+  (*l_bv) = iValue;
+  // operator= only carries the a-values.
+  if(l_bv->m_bval != nullptr)
+  {
+    for(UInt32 kk=0; kk<l_bv->m_bval->size(); kk++)
+    {
+      bool l_have = (iValue.m_bval != nullptr) && (kk < iValue.m_bval->size());
+      (*l_bv->m_bval)[kk] = l_have ? (*iValue.m_bval)[kk] : 0;
+    }
+  }
+}
+void SignalBundle::Set(UInt32 iIdx, UInt64 iValue)
+{
+  BitVector * l_bv = stage(iIdx);
+  if(l_bv == nullptr)
+  {
+    return;
+  }
+  (*l_bv) = iValue;
+  if(l_bv->m_bval != nullptr)
+  {
+    fill(l_bv->m_bval->begin(), l_bv->m_bval->end(), 0);
+  }
+}
+void SignalBundle::Apply()
+{
+  // Each member goes through its own write mode, so DEFERRED members
+  // still coalesce with any other writes in this timestep.
+  for(UInt32 ii=0; ii<m_members.size(); ii++)
+  {
+    Member & l_mbr = m_members[ii];
+    if(l_mbr.staged == nullptr)
+    {
+      continue;
+    }
+    BitVector & l_bv = l_mbr.sig->get_BitVector();
+    for(UInt32 kk=0; kk<l_mbr.nbWords; kk++)
+    {
+      (*l_bv.m_aval)[kk] = (*l_mbr.staged->m_aval)[kk];
+      if((l_bv.m_bval != nullptr) && (l_mbr.staged->m_bval != nullptr))
+      {
+        (*l_bv.m_bval)[kk] = (*l_mbr.staged->m_bval)[kk];
+      }
+    }
+    l_mbr.sig->set_RtlValue();
+    delete l_mbr.staged;
+    l_mbr.staged = nullptr;
+  }
+}
+void SignalBundle::Discard()
+{
+  for(UInt32 ii=0; ii<m_members.size(); ii++)
+  {
+    if(m_members[ii].staged != nullptr)
+    {
+      delete m_members[ii].staged;
+      m_members[ii].staged = nullptr;
+    }
+  }
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool SignalBundle::checkIndex(UInt32 iIdx) const
+{
+  if(iIdx >= m_members.size())
+  {
+    LOG_ERR_ENV << "Bundle '" << m_name << "' has " << m_members.size()
+                << " members, index " << iIdx << " is out of range." << endl;
+    return false;
+  }
+  return true;
+}
+BitVector * SignalBundle::stage(UInt32 iIdx)
+{
+  if(!checkIndex(iIdx))
+  {
+    return nullptr;
+  }
+  Member & l_mbr = m_members[iIdx];
+  if(l_mbr.staged == nullptr)
+  {
+    const BitVector & l_cur = l_mbr.sig->get_BitVector();
+    l_mbr.staged = new BitVector(l_mbr.sig->Get_NameFull(), l_mbr.size,
+                                 (l_cur.m_bval != nullptr) ? NB_STATES::FOUR_STATE : NB_STATES::TWO_STATE);
+  }
+  return l_mbr.staged;
+}
+
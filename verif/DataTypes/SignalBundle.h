@@ -0,0 +1,110 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   SignalBundle.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Groups TypeBase signals that move together (i.e. the
+#                     ports of one interface, since Icarus has none).
+#                     Snapshot() captures every member at the same instant
+#                     into one packed word array; SampleOn() does it on every
+#                     edge of a Clock, ahead of its other subscribers, and
+#                     fires _Sampled.
+#                     Set() stages writes which Apply() pushes together.
+#
+#                     Usage:
+#                       SignalBundle l_wr("wr");
+#                       UInt32 c_data = l_wr.Add(wr_data);
+#                       UInt32 c_en   = l_wr.Add(wr_en);
+#                       l_wr.SampleOn("top.clk_w");
+#                       ...
+#                       l_wr.Set(c_data, 0x1234);
+#                       l_wr.Set(c_en, 1);
+#                       l_wr.Apply();
+#
+###############################################################################
+*/
+#ifndef SIGNALBUNDLE_H
+#define SIGNALBUNDLE_H
+
+#include <string>
+#include <vector>
+
+#include "BitVector.h"
+#include "Clock.h"
+#include "Common.h"
+#include "Event.h"
+#include "TypeBase.h"
+#include "vpi.h"
+
+using namespace std;
+
+class SignalBundle
+{
+  // Nested Classes
+  public:
+  // Where a member lives in the packed snapshot.
+  struct Member
+  {
+    TypeBase *  sig;
+    UInt32      size;
+    UInt32      offset;     // First word in the snapshot.
+    UInt32      nbWords;
+    BitVector * staged;     // Pending write, nullptr when none.
+  };
+
+  // Private Members
+  private:
+    string            m_name;
+    vector<Member>    m_members;
+    vector<UInt32>    m_aval;     // Snapshot, members packed word aligned in Add() order.
+    vector<UInt32>    m_bval;     // Zero for 2-state members.
+    UInt64            m_snapCount;
+    Clock *           m_clock;
+    Clock::Id         m_clkSub;
+
+  // Public Properties
+  public:
+    string          Name_get() const                { return m_name; }
+    UInt32          Count_get() const               { return m_members.size(); }
+    UInt32          Words_get() const               { return m_aval.size(); }
+    const UInt32 *  Aval_get() const                { return m_aval.data(); }
+    const UInt32 *  Bval_get() const                { return m_bval.data(); }
+    const Member &  Member_get(UInt32 iIdx) const   { return m_members[iIdx]; }
+    UInt64          SnapshotCount_get() const       { return m_snapCount; }
+
+    // Fired after every clock driven snapshot (see SampleOn).
+    Event<void>     _Sampled;
+
+  // Constructors
+  public:
+    SignalBundle(string iName);
+    ~SignalBundle();
+
+  // Public Methods
+  public:
+    UInt32    Add(TypeBase & iSig);
+    Int32     IndexOf(const string & iName) const;
+    void      Snapshot();
+    bool      SampleOn(string iClockName, Vpi::EDGE iEdge = Vpi::EDGE::POSEDGE);
+    void      StopSampling();
+    BitVector Get(UInt32 iIdx) const;
+    UInt32    GetWord(UInt32 iIdx, UInt32 iWord = 0) const;
+    void      Set(UInt32 iIdx, const BitVector & iValue);
+    void      Set(UInt32 iIdx, UInt64 iValue);
+    void      Apply();
+    void      Discard();
+
+  // Private Methods
+  private:
+    bool          checkIndex(UInt32 iIdx) const;
+    BitVector *   stage(UInt32 iIdx);
+};
+
+#endif /* SIGNALBUNDLE_H */
+
@@ -14,12 +14,15 @@
 ###############################################################################
 */
 
+#include <algorithm>
 #include <iostream>
 
 #include "BitVector.h"
+#include "hierarchy.h"
 #include "Logger.h"
 #include "Manip.h"
 #include "pli.h"
+#include "region_queue.h"
 #include "vpi_entry.h"
 
 #include "TypeBase.h"
@@ -29,14 +32,99 @@ using namespace Text;
 // ====================================
 // ===**  Private Static Members  **===
 // ====================================
+TypeBase::WRITE_MODE              TypeBase::s_defaultWriteMode = TypeBase::WRITE_MODE::IMMEDIATE;
+vector<TypeBase::Mirror *>        TypeBase::s_dirtyList;
+bool                              TypeBase::s_flushPending = false;
+TypeBase::SAMPLE_MODE             TypeBase::s_defaultSampleMode = TypeBase::SAMPLE_MODE::EAGER;
+vector<TypeBase::ClockSampler *>  TypeBase::s_samplers;
+vector<TypeBase::Mirror *>        TypeBase::s_settleList;
+bool                              TypeBase::s_settlePending = false;
+map<string, TypeBase::Mirror *>   TypeBase::s_registry;
 
 // ================================
 // ===** Protected Properties **===
 // ================================
+void TypeBase::set_Size(UInt32 iSize)
+{
+  if(get_Shared() && (m_mirror->m_size != iSize))
+  {
+    // The storage differs (i.e. an Integer and a Logic of another width).
+    LOG_WRN_ENV << "Signal '" << m_nameFull << "' is already bound with " << m_mirror->m_size
+                << " bits, this " << iSize << " bit binding will not be shared." << endl;
+    NB_STATES l_states = m_mirror->m_nbStates;
+    vpiHandle l_hndl = m_mirror->m_sigHandle;
+    m_mirror->m_refCount--;
+    m_mirror = new Mirror(m_nameFull, l_states);
+    m_mirror->m_sigHandle = l_hndl;
+  }
+  m_mirror->m_size = iSize;
+}
 
 // =============================
 // ===** Public Properties **===
 // =============================
+void TypeBase::Set_WriteMode(WRITE_MODE iMode)
+{
+  if((iMode == WRITE_MODE::IMMEDIATE) && m_mirror->m_dirty)
+  {
+    // Don't leave a pending value behind when switching back.
+    Flush();
+  }
+  m_mirror->m_writeMode = iMode;
+}
+void TypeBase::Set_SampleMode(SAMPLE_MODE iMode)
+{
+  if(iMode == SAMPLE_MODE::CLOCKED)
+  {
+    LOG_ERR_ENV << "Use Set_SampleClock() to sample '" << m_nameFull << "' on a clock." << endl;
+    return;
+  }
+  if(iMode == m_mirror->m_sampleMode)
+  {
+    return;
+  }
+  m_mirror->detachSampling();
+  m_mirror->m_sampleMode = iMode;
+  m_mirror->registerValChangeCB();
+  // Nothing was tracking the RTL while switching over.
+  if(m_mirror->m_bv != nullptr)
+  {
+    get_RtlValue();
+  }
+}
+bool TypeBase::Set_SampleClock(string iClockName, Vpi::EDGE iEdge)
+{
+  if((iEdge != Vpi::EDGE::POSEDGE) && (iEdge != Vpi::EDGE::NEGEDGE) && (iEdge != Vpi::EDGE::ANY_EDGE))
+  {
+    LOG_ERR_ENV << "Sampling edge must be POSEDGE, NEGEDGE or ANY_EDGE (got " << (Int32)iEdge << ")." << endl;
+    return false;
+  }
+  ClockSampler * l_sampler = getSampler(iClockName, iEdge);
+  if(l_sampler == nullptr)
+  {
+    return false;
+  }
+  m_mirror->detachSampling();
+  m_mirror->m_sampleMode = SAMPLE_MODE::CLOCKED;
+  m_mirror->m_sampler = l_sampler;
+  l_sampler->signals.push_back(m_mirror);
+  // Subscribers still need the signal's own callback.
+  m_mirror->registerValChangeCB();
+  if(m_mirror->m_bv != nullptr)
+  {
+    get_RtlValue();
+  }
+  return true;
+}
+void TypeBase::Set_DefaultSampleMode(SAMPLE_MODE iMode)
+{
+  if(iMode == SAMPLE_MODE::CLOCKED)
+  {
+    LOG_ERR_ENV << "CLOCKED needs a clock and can't be the default sample mode." << endl;
+    return;
+  }
+  s_defaultSampleMode = iMode;
+}
 
 // =============================
 // ===**   Constructors    **===
@@ -51,7 +139,16 @@ TypeBase::TypeBase(string iFullName, NB_STATES iStates)
 }
 TypeBase::~TypeBase()
 {
-  unregisterValChangeCB();
+  m_mirror->m_refCount--;
+  if(m_mirror->m_refCount > 0)
+  {
+    return;
+  }
+  if(m_mirror->m_registered)
+  {
+    s_registry.erase(m_mirror->m_nameFull);
+  }
+  delete m_mirror;
 }
 
 // =============================
@@ -60,8 +157,6 @@ TypeBase::~TypeBase()
 bool TypeBase::init(string iFullName, NB_STATES iValue)
 {
   m_nameFull = iFullName;
-  m_nbStates = iValue;
-  m_maskValChange = false;
   vector<string> l_layers = Manip::Split(iFullName, '.');
   if(l_layers.size() > 0)
   {
@@ -73,11 +168,32 @@ bool TypeBase::init(string iFullName, NB_STATES iValue)
     m_name = m_nameFull;
   }
 
-  if(!set_Handle())
+  map<string, Mirror *>::iterator l_it = s_registry.find(m_nameFull);
+  if(l_it != s_registry.end())
+  {
+    if(l_it->second->m_nbStates == iValue)
+    {
+      LOG_DEBUG << "Signal '" << m_nameFull << "' is already bound, sharing it." << endl;
+      m_mirror = l_it->second;
+      m_mirror->m_refCount++;
+      return true;
+    }
+    // The storage differs, so this binding can't share the mirror.
+    LOG_WRN_ENV << "Signal '" << m_nameFull << "' is already bound as a "
+                << ((iValue == NB_STATES::TWO_STATE) ? "4" : "2")
+                << "-state type. This binding will not be shared." << endl;
+  }
+
+  m_mirror = new Mirror(m_nameFull, iValue);
+  if(!m_mirror->set_Handle())
   {
     return false;
   }
-  registerValChangeCB();
+  if(l_it == s_registry.end())
+  {
+    s_registry[m_nameFull] = m_mirror;
+    m_mirror->m_registered = true;
+  }
   return true;
 }
 
@@ -86,74 +202,309 @@ bool TypeBase::init(string iFullName, NB_STATES iValue)
 // =============================
 BitVector TypeBase::Get_Value()
 {
-  get_RtlValue();
-  return *m_bv;
+  // A pending (deferred) write is newer than what the RTL holds.
+  // LAZY imports through get_BitVector() and CLOCKED returns the last sample.
+  if(!m_mirror->m_dirty && (m_mirror->m_sampleMode == SAMPLE_MODE::EAGER))
+  {
+    get_RtlValue();
+  }
+  return get_BitVector();
 }
 string TypeBase::ToString() const
 {
-  return m_bv->ToString();
+  return get_BitVector().ToString();
 }
 void TypeBase::Print() const
 {
-  m_bv->Print();
+  get_BitVector().Print();
+}
+void TypeBase::Flush()
+{
+  if(!m_mirror->m_dirty)
+  {
+    return;
+  }
+  s_dirtyList.erase(remove(s_dirtyList.begin(), s_dirtyList.end(), m_mirror), s_dirtyList.end());
+  m_mirror->write();
+}
+void TypeBase::Schedule(UInt64 iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode)
+{
+  BitVector l_val(m_nameFull, m_mirror->m_size, m_mirror->m_nbStates);
+  l_val = iValue;
+  schedule(l_val, iDelay, iMode);
+}
+void TypeBase::Schedule(const BitVector & iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode)
+{
+  // Sized to the signal so narrower values clear the upper words.
+  BitVector l_val(m_nameFull, m_mirror->m_size, m_mirror->m_nbStates);
+  l_val = iValue;
+  if((l_val.m_bval != nullptr) && (iValue.m_bval != nullptr))
+  {
+    for(UInt32 kk=0; (kk<l_val.m_bval->size()) && (kk<iValue.m_bval->size()); kk++)
+    {
+      (*l_val.m_bval)[kk] = (*iValue.m_bval)[kk];
+    }
+  }
+  schedule(l_val, iDelay, iMode);
+}
+void TypeBase::ScheduleWave(const vector<UInt64> & iValues, UInt64 iPeriod, UInt64 iStart)
+{
+  BitVector l_val(m_nameFull, m_mirror->m_size, m_mirror->m_nbStates);
+  for(UInt32 ii=0; ii<iValues.size(); ii++)
+  {
+    l_val = iValues[ii];
+    schedule(l_val, iStart + ii * iPeriod, Vpi::DELAY_MODE::TRANSPORT_DELAY);
+  }
+}
+void TypeBase::ScheduleWave(const vector<BitVector> & iValues, UInt64 iPeriod, UInt64 iStart)
+{
+  for(UInt32 ii=0; ii<iValues.size(); ii++)
+  {
+    Schedule(iValues[ii], iStart + ii * iPeriod, Vpi::DELAY_MODE::TRANSPORT_DELAY);
+  }
+}
+void TypeBase::OnValue(UInt64 iValue, function<void()> iFn)
+{
+  Subscribers::ValueWatch l_watch;
+  l_watch.value = iValue;
+  l_watch.once = false;
+  l_watch.fn = iFn;
+  m_mirror->subscribers().values.push_back(l_watch);
+}
+void TypeBase::WaitValue(UInt64 iValue, function<void()> iFn)
+{
+  Subscribers::ValueWatch l_watch;
+  l_watch.value = iValue;
+  l_watch.once = true;
+  l_watch.fn = iFn;
+  m_mirror->subscribers().values.push_back(l_watch);
+}
+void TypeBase::FlushAll()
+{
+  // write() may re-enter through the value change callback,
+  // so work from a local copy of the list.
+  vector<Mirror *> l_list;
+  l_list.swap(s_dirtyList);
+  for(UInt32 ii=0; ii<l_list.size(); ii++)
+  {
+    if(l_list[ii]->m_dirty)
+    {
+      l_list[ii]->write();
+    }
+  }
 }
 
 // =============================
 // ===**  Private Methods  **===
 // =============================
-void TypeBase::registerValChangeCB()
+void TypeBase::flush()
 {
-  Vpi::t_cb_data l_cb_data;
-  Vpi::t_vpi_time l_vpi_time;
-  Vpi::t_vpi_value l_vpi_value;
+  s_flushPending = false;
+  FlushAll();
+}
+void TypeBase::settle()
+{
+  s_settlePending = false;
+  // Take the list first so the next timestep starts a new one.
+  vector<Mirror *> l_list;
+  l_list.swap(s_settleList);
+  for(UInt32 ii=0; ii<l_list.size(); ii++)
+  {
+    l_list[ii]->m_settlePending = false;
+  }
+  for(UInt32 ii=0; ii<l_list.size(); ii++)
+  {
+    Mirror * l_sig = l_list[ii];
+    if(l_sig->m_dirty)
+    {
+      // The pending write wins, as for the other modes.
+      continue;
+    }
+    vector<UInt32> l_aval = *l_sig->m_bv->m_aval;
+    vector<UInt32> l_bval;
+    if(l_sig->m_bv->m_bval != nullptr)
+    {
+      l_bval = *l_sig->m_bv->m_bval;
+    }
+    l_sig->read();
+    bool l_changed = (l_aval != *l_sig->m_bv->m_aval) ||
+                     ((l_sig->m_bv->m_bval != nullptr) && (l_bval != *l_sig->m_bv->m_bval));
+    if(l_changed && (l_sig->m_subs != nullptr))
+    {
+      Vpi::t_vpi_value l_data;
+      l_data.format = l_sig->m_xport.format;
+      Vpi::vpi_get_value(l_sig->m_sigHandle, &l_data);
+      l_sig->dispatch(&l_data);
+    }
+  }
+}
+TypeBase::ClockSampler * TypeBase::getSampler(string iClockName, Vpi::EDGE iEdge)
+{
+  for(UInt32 ii=0; ii<s_samplers.size(); ii++)
+  {
+    if((s_samplers[ii]->clockName == iClockName) && (s_samplers[ii]->edge == iEdge))
+    {
+      return s_samplers[ii];
+    }
+  }
 
-  l_vpi_time.type = Vpi::TIME_TYPE::SCALED_REAL_TIME;
-  l_vpi_value.format = Vpi::VALUE_FORMAT::VECTOR;
+  Clock * l_clock = Clock::Get(iClockName);
+  if(l_clock == nullptr)
+  {
+    return nullptr;
+  }
 
-  l_cb_data.reason = Vpi::CB_REASON::VALUE_CHANGE;
-  l_cb_data.cb_rtn = s_valueChangedCB;
-  l_cb_data.obj = m_sigHandle;
-  l_cb_data.time = &l_vpi_time;
-  l_cb_data.value = &l_vpi_value;
-  l_cb_data.index = 0;
-  l_cb_data.user_data = (char *)this;
+  ClockSampler * l_sampler = new ClockSampler();
+  l_sampler->clockName = iClockName;
+  l_sampler->clock = l_clock;
+  l_sampler->edge = iEdge;
+  // Ahead of the clock's other subscribers, so they read sampled values.
+  l_sampler->subscription = l_clock->Subscribe([l_sampler]() { sample(l_sampler); },
+                                               Clock::c_samplePriority, iEdge);
+  if(l_sampler->subscription == 0)
+  {
+    delete l_sampler;
+    return nullptr;
+  }
+  s_samplers.push_back(l_sampler);
+  return l_sampler;
+}
+void TypeBase::sample(ClockSampler * iSampler)
+{
+  // This runs as the clock changes, before the NBA region, so flops
+  // clocked by the same edge still show their pre-edge values.
+  for(UInt32 ii=0; ii<iSampler->signals.size(); ii++)
+  {
+    Mirror * l_sig = iSampler->signals[ii];
+    if(!l_sig->m_dirty)
+    {
+      l_sig->read();
+    }
+  }
+}
 
-  m_callBackHandle = Vpi::vpi_register_cb(&l_cb_data);
+void TypeBase::schedule(const BitVector & iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode)
+{
+  if(m_mirror->m_bv == nullptr)
+  {
+    LOG_ERR_ENV << "Signal '" << m_nameFull << "' is not bound, can't schedule a write." << endl;
+    return;
+  }
+  // A deferred write would land after (and override) a zero delay event.
+  Flush();
+  Pli::SetVectorDelayed(m_mirror->m_xport, iValue.m_aval->data(),
+                        (iValue.m_bval != nullptr) ? iValue.m_bval->data() : nullptr, iDelay, iMode);
 }
-void TypeBase::unregisterValChangeCB()
+
+void TypeBase::addWaiter(Vpi::EDGE iEdge, UInt32 iCount, function<void()> iFn)
 {
-  if(!Vpi::vpi_remove_cb(m_callBackHandle))
+  if(iCount == 0)
   {
-    LOG_WRN_ENV << "vpi_remove_cb should have returned 1 and did not." << endl;
+    iFn();
+    return;
   }
+  Subscribers::Waiter l_waiter;
+  l_waiter.edge = iEdge;
+  l_waiter.count = iCount;
+  l_waiter.fn = iFn;
+  m_mirror->subscribers().waiters.push_back(l_waiter);
 }
-Int32 TypeBase::valueChangedCB(Vpi::t_cb_data * iData)
+
+// =============================
+// ===** Protected Methods **===
+// =============================
+void TypeBase::createBV()
+{
+  m_mirror->m_bv = new BitVector(m_nameFull, m_mirror->m_size, m_mirror->m_nbStates);
+  Pli::InitVectorContext(m_mirror->m_sigHandle, m_mirror->m_size, m_mirror->m_xport);
+  // Registered once the size is known so the callback can use the native format.
+  m_mirror->registerValChangeCB();
+}
+void TypeBase::get_RtlValue()
 {
-  if(!m_maskValChange)
+  m_mirror->read();
+}
+void TypeBase::set_RtlValue()
+{
+  if(m_mirror->m_writeMode == WRITE_MODE::DEFERRED)
   {
-    Pli::ImportVector(iData->value, m_bv->m_aval->size(), m_bv->m_aval, m_bv->m_bval);
+    m_mirror->markDirty();
   }
   else
   {
-    m_maskValChange = false;
+    m_mirror->write();
   }
-  return 0;
 }
-Int32 TypeBase::s_valueChangedCB(Vpi::t_cb_data * iData)
+
+// =============================
+// ===**     Operators     **===
+// =============================
+TypeBase::PartSelect TypeBase::operator() (UInt32 iUpperIndex, UInt32 iLowerIndex)
 {
-  TypeBase* l_inst = (TypeBase*)iData->user_data;
-  l_inst->valueChangedCB(iData);
-  return 0;
+  LOG_DEBUG << __PRETTY_FUNCTION__ << endl;
+  TypeBase::PartSelect l_retVal(this, iUpperIndex, iLowerIndex);
+  return l_retVal;
 }
 
+
+// *==*==*==*==*==*==*==*==*==*==*==*==*
+// ===**       Mirror Class       **===
+// *==*==*==*==*==*==*==*==*==*==*==*==*
+
 // =============================
-// ===** Protected Methods **===
+// ===**   Constructors    **===
+// =============================
+TypeBase::Mirror::Mirror(string iFullName, NB_STATES iStates)
+{
+  m_nameFull = iFullName;
+  m_nbStates = iStates;
+  m_sigHandle = NULL;
+  m_callBackHandle = NULL;
+  m_size = 0;
+  m_bv = nullptr;
+  m_writeMode = s_defaultWriteMode;
+  m_dirty = false;
+  m_sampleMode = s_defaultSampleMode;
+  m_stale = false;
+  m_sampler = nullptr;
+  m_refCount = 1;
+  m_registered = false;
+  m_subs = nullptr;
+  m_settlePending = false;
+}
+TypeBase::Mirror::~Mirror()
+{
+  if(m_dirty)
+  {
+    // The pending write is dropped, the object can't be flushed once it is gone.
+    LOG_WRN_ENV << "Signal '" << m_nameFull << "' destroyed with an unflushed write." << endl;
+    s_dirtyList.erase(remove(s_dirtyList.begin(), s_dirtyList.end(), this), s_dirtyList.end());
+  }
+  detachSampling();
+  if(m_subs != nullptr)
+  {
+    delete m_subs->value;
+    delete m_subs;
+  }
+  if(m_bv != nullptr)
+  {
+    delete m_bv;
+  }
+}
+
 // =============================
-bool TypeBase::set_Handle()
+// ===**  Private Methods  **===
+// =============================
+bool TypeBase::Mirror::set_Handle()
 {
 
   LOG_DEBUG << "Looking for signal '" << m_nameFull << "'" << endl;
-  m_sigHandle = Vpi::vpi_handle_by_name(m_nameFull.c_str(), vpi_entry::TopModule_get());
+  m_sigHandle = Hierarchy::Find(m_nameFull);
+  if(m_sigHandle == NULL)
+  {
+    // Not in the index (i.e. a bit/part select), ask the simulator.
+    m_sigHandle = Vpi::vpi_handle_by_name(m_nameFull.c_str(), vpi_entry::TopModule_get());
+  }
   if(m_sigHandle == NULL) 
   {
     LOG_WRN_ENV << "Could not find signal '" << m_nameFull << "'" << endl;
@@ -165,48 +516,258 @@ bool TypeBase::set_Handle()
     return true;
   }
 }
-void TypeBase::createBV()
+void TypeBase::Mirror::registerValChangeCB()
 {
-  m_bv = new BitVector(m_nameFull, m_size, m_nbStates);
+  Vpi::t_cb_data l_cb_data;
+  Vpi::t_vpi_time l_vpi_time;
+  Vpi::t_vpi_value l_vpi_value;
+
+  if((m_sampleMode == SAMPLE_MODE::CLOCKED) && (m_subs == nullptr))
+  {
+    // The clock sampler does the reads.
+    return;
+  }
+  if(((m_sampleMode != SAMPLE_MODE::EAGER) && (m_subs == nullptr)) || (m_sampleMode == SAMPLE_MODE::SETTLED))
+  {
+    // Only the notification is needed, don't have the simulator build the value.
+    l_vpi_time.type = Vpi::TIME_TYPE::SUPPRESS_TIME;
+    l_vpi_value.format = Vpi::VALUE_FORMAT::SUPPRESS;
+  }
+  else
+  {
+    l_vpi_time.type = Vpi::TIME_TYPE::SCALED_REAL_TIME;
+    // Same compact format as the reads/writes (scalar for 1-bit, int for integers).
+    l_vpi_value.format = m_xport.format;
+  }
+
+  l_cb_data.reason = Vpi::CB_REASON::VALUE_CHANGE;
+  l_cb_data.cb_rtn = s_valueChangedCB;
+  l_cb_data.obj = m_sigHandle;
+  l_cb_data.time = &l_vpi_time;
+  l_cb_data.value = &l_vpi_value;
+  l_cb_data.index = 0;
+  l_cb_data.user_data = (char *)this;
+
+  m_callBackHandle = Vpi::vpi_register_cb(&l_cb_data);
 }
-void TypeBase::get_RtlValue()
+void TypeBase::Mirror::unregisterValChangeCB()
+{
+  if(m_callBackHandle == NULL)
+  {
+    return;
+  }
+  if(!Vpi::vpi_remove_cb(m_callBackHandle))
+  {
+    LOG_WRN_ENV << "vpi_remove_cb should have returned 1 and did not." << endl;
+  }
+  m_callBackHandle = NULL;
+}
+void TypeBase::Mirror::detachSampling()
+{
+  unregisterValChangeCB();
+  m_stale = false;
+  if(m_settlePending)
+  {
+    s_settleList.erase(remove(s_settleList.begin(), s_settleList.end(), this), s_settleList.end());
+    m_settlePending = false;
+  }
+  if(m_sampler == nullptr)
+  {
+    return;
+  }
+  vector<Mirror *> & l_sigs = m_sampler->signals;
+  l_sigs.erase(remove(l_sigs.begin(), l_sigs.end(), this), l_sigs.end());
+  if(l_sigs.size() == 0)
+  {
+    // Last signal on this clock/edge, drop the shared subscription.
+    m_sampler->clock->Cancel(m_sampler->subscription);
+    s_samplers.erase(remove(s_samplers.begin(), s_samplers.end(), m_sampler), s_samplers.end());
+    delete m_sampler;
+  }
+  m_sampler = nullptr;
+}
+void TypeBase::Mirror::markDirty()
 {
+  if(m_dirty)
+  {
+    return;
+  }
+  m_dirty = true;
+  s_dirtyList.push_back(this);
+  if(!s_flushPending)
+  {
+    // After the NBA work that may still write, one flush for all of it.
+    s_flushPending = RegionQueue::Post(RegionQueue::REGION::NBA, flush, RegionQueue::c_flushPriority);
+  }
+}
+void TypeBase::Mirror::read()
+{
+  m_stale = false;
   if(m_nbStates == NB_STATES::TWO_STATE)
   {
-    Pli::GetVector(get_SigHandle(), m_bv->m_aval);
+    Pli::GetVector(m_xport, m_bv->m_aval);
   }
   else
   {
-    Pli::GetVector(get_SigHandle(), m_bv->m_aval, m_bv->m_bval);
+    Pli::GetVector(m_xport, m_bv->m_aval, m_bv->m_bval);
   }
 }
-void TypeBase::set_RtlValue()
+void TypeBase::Mirror::write()
 {
-  // * This masking is not thread safe. *
-  // Not fixing it now because I can't think of any scenario
-  // where a C thread is actively running in parallel with
-  // the simulator (the scheduler running).
-  // As long as there is no chance the C thread will be interrupted
-  // while the simulator continues, we should be okay.
-  m_maskValChange = true;
+  // Clear first: the put can fire our own value change callback, which
+  // then simply re-imports the value being written.
+  m_dirty = false;
   if(m_nbStates == NB_STATES::TWO_STATE)
   {
-    Pli::SetVector(get_SigHandle(), m_bv->m_aval);
+    Pli::SetVector(m_xport, m_bv->m_aval);
   }
   else
   {
-    Pli::SetVector(get_SigHandle(), m_bv->m_aval, m_bv->m_bval);
+    Pli::SetVector(m_xport, m_bv->m_aval, m_bv->m_bval);
+  }
+}
+TypeBase::Subscribers & TypeBase::Mirror::subscribers()
+{
+  if(m_subs != nullptr)
+  {
+    return *m_subs;
+  }
+  m_subs = new Subscribers();
+  m_subs->value = nullptr;
+  m_subs->lastLsb = Vpi::SCALAR_VAL::X;
+  if(m_sigHandle != NULL)
+  {
+    Vpi::t_vpi_value l_data;
+    l_data.format = m_xport.format;
+    Vpi::vpi_get_value(m_sigHandle, &l_data);
+    m_subs->lastLsb = Pli::ValueLsb(&l_data);
   }
+  // LAZY and CLOCKED signals have no value in (or no) callback, the filters need it.
+  unregisterValChangeCB();
+  registerValChangeCB();
+  return *m_subs;
 }
+void TypeBase::Mirror::dispatch(Vpi::p_vpi_value iValue)
+{
+  Subscribers & l_subs = *m_subs;
+  bool l_rise;
+  bool l_fall;
+  Clock::Transition(l_subs.lastLsb, Pli::ValueLsb(iValue), l_rise, l_fall);
 
-// =============================
-// ===**     Operators     **===
-// =============================
-TypeBase::PartSelect TypeBase::operator() (UInt32 iUpperIndex, UInt32 iLowerIndex)
+  l_subs.change();
+  if(l_rise)
+  {
+    l_subs.posedge();
+  }
+  if(l_fall)
+  {
+    l_subs.negedge();
+  }
+
+  // User code may subscribe again from inside a handler, so the
+  // matches are taken out of the lists before any of them runs.
+  vector<function<void()>> l_ready;
+  if(l_subs.values.size() > 0)
+  {
+    if(l_subs.value == nullptr)
+    {
+      l_subs.value = new BitVector(m_nameFull, m_size, m_nbStates);
+    }
+    Pli::ImportValue(m_xport, iValue, l_subs.value->m_aval, l_subs.value->m_bval);
+    bool l_known = true;
+    UInt64 l_val = 0;
+    for(UInt32 ii=0; ii<l_subs.value->m_aval->size(); ii++)
+    {
+      if((l_subs.value->m_bval != nullptr) && ((*l_subs.value->m_bval)[ii] != 0))
+      {
+        l_known = false;
+      }
+      else if(ii < 2)
+      {
+        l_val |= (UInt64)(*l_subs.value->m_aval)[ii] << (ii * 32);
+      }
+      else if((*l_subs.value->m_aval)[ii] != 0)
+      {
+        // Wider than any UInt64 watch.
+        l_known = false;
+      }
+    }
+    for(UInt32 ii=0; l_known && (ii<l_subs.values.size()); )
+    {
+      if(l_subs.values[ii].value != l_val)
+      {
+        ii++;
+        continue;
+      }
+      l_ready.push_back(l_subs.values[ii].fn);
+      if(l_subs.values[ii].once)
+      {
+        l_subs.values.erase(l_subs.values.begin() + ii);
+      }
+      else
+      {
+        ii++;
+      }
+    }
+  }
+  for(UInt32 ii=0; ii<l_subs.waiters.size(); )
+  {
+    Subscribers::Waiter & l_waiter = l_subs.waiters[ii];
+    bool l_hit = (l_waiter.edge == Vpi::EDGE::NO_EDGE) ||
+                 ((l_waiter.edge == Vpi::EDGE::POSEDGE) && l_rise) ||
+                 ((l_waiter.edge == Vpi::EDGE::NEGEDGE) && l_fall);
+    if(l_hit && (--l_waiter.count == 0))
+    {
+      l_ready.push_back(l_waiter.fn);
+      l_subs.waiters.erase(l_subs.waiters.begin() + ii);
+    }
+    else
+    {
+      ii++;
+    }
+  }
+  for(UInt32 ii=0; ii<l_ready.size(); ii++)
+  {
+    l_ready[ii]();
+  }
+}
+Int32 TypeBase::Mirror::s_valueChangedCB(Vpi::t_cb_data * iData)
 {
-  LOG_DEBUG << __PRETTY_FUNCTION__ << endl;
-  TypeBase::PartSelect l_retVal(this, iUpperIndex, iLowerIndex);
-  return l_retVal;
+  Mirror * l_inst = (Mirror *)iData->user_data;
+  if(l_inst->m_sampleMode == SAMPLE_MODE::SETTLED)
+  {
+    // Deltas only queue the signal, it is read once the timestep has settled.
+    if(!l_inst->m_settlePending)
+    {
+      l_inst->m_settlePending = true;
+      s_settleList.push_back(l_inst);
+      if(!s_settlePending)
+      {
+        // Before the read-only work, it checks against the settled values.
+        s_settlePending = RegionQueue::Post(RegionQueue::REGION::READ_ONLY, settle,
+                                            RegionQueue::c_samplePriority);
+      }
+    }
+    return 0;
+  }
+  // While a write is pending the local value wins; it will be
+  // pushed to the RTL at the next flush.
+  if(!l_inst->m_dirty)
+  {
+    if(l_inst->m_sampleMode == SAMPLE_MODE::LAZY)
+    {
+      l_inst->m_stale = true;
+    }
+    else if(l_inst->m_sampleMode == SAMPLE_MODE::EAGER)
+    {
+      Pli::ImportValue(l_inst->m_xport, iData->value, l_inst->m_bv->m_aval, l_inst->m_bv->m_bval);
+    }
+  }
+  if(l_inst->m_subs != nullptr)
+  {
+    l_inst->dispatch(iData->value);
+  }
+  return 0;
 }
 
 
@@ -229,134 +790,134 @@ TypeBase::PartSelect::PartSelect(TypeBase * iTB, UInt32 iUpperIndex, UInt32 iLow
 // =============================
 TypeBase::PartSelect & TypeBase::PartSelect::operator= (UInt32 iRhs)
 {
-  (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) = iRhs;
+  m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) = iRhs;
   m_parent->set_RtlValue();
   return *this;
 }
 TypeBase::PartSelect & TypeBase::PartSelect::operator= (UInt64 iRhs)
 {
-  (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) = iRhs;
+  m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) = iRhs;
   m_parent->set_RtlValue();
   return *this;
 }
 TypeBase::PartSelect & TypeBase::PartSelect::operator= (BitVector & iRhs)
 {
-  (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) = iRhs;
+  m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) = iRhs;
   m_parent->set_RtlValue();
   return *this;
 }
 TypeBase::PartSelect & TypeBase::PartSelect::operator= (BitVector && iRhs)
 {
-  (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) = move(iRhs);
+  m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) = move(iRhs);
   m_parent->set_RtlValue();
   return *this;
 }
 TypeBase::PartSelect & TypeBase::PartSelect::operator= (const BitVector::PartSelect & iRhs)
 {
-  (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) = iRhs;
+  m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) = iRhs;
   m_parent->set_RtlValue();
   return *this;
 }
 BitVector TypeBase::PartSelect::operator+= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) += iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) += iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
   //return l_retVal;
 }
 BitVector TypeBase::PartSelect::operator+= (UInt64 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) += iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) += iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator+= (const BitVector & iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) += iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) += iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator-= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) -= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) -= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator-= (UInt64 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) -= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) -= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator-= (const BitVector & iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) -= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) -= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator<<= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) <<= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) <<= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator>>= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) >>= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) >>= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator&= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) &= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) &= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator&= (UInt64 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) &= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) &= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator&= (const BitVector & iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) &= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) &= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator|= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) |= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) |= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator|= (UInt64 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) |= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) |= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator|= (const BitVector & iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) |= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) |= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator^= (UInt32 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) ^= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) ^= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator^= (UInt64 iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) ^= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) ^= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
 BitVector TypeBase::PartSelect::operator^= (const BitVector & iRhs)
 {
-  BitVector && l_retVal = (*m_parent->m_bv)(m_upperIndex, m_lowerIndex) ^= iRhs;
+  BitVector && l_retVal = m_parent->get_BitVector()(m_upperIndex, m_lowerIndex) ^= iRhs;
   m_parent->set_RtlValue();
   return move(l_retVal);
 }
@@ -16,10 +16,16 @@
 #ifndef TYPEBASE_H
 #define TYPEBASE_H
 
+#include <functional>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "BitVector.h"
+#include "Clock.h"
 #include "Common.h"
+#include "Event.h"
+#include "pli.h"
 #include "vpi.h"
 
 using namespace std;
@@ -29,15 +35,136 @@ using namespace std;
 // 2-state child will only have the 'bit' class.
 // 4-state children will be logic, (typedef reg to be same as logic), & integer (32-bit BV).
 
-// TBD - Make a list/map structure to register each signal that is attached to the rtl.
-//       Warn the user if the same signal is attached multiple times.
+// Every signal attached to the rtl is kept in a registry (s_registry) keyed by its
+// full name. Binding the same signal again (i.e. from a driver and a monitor) shares
+// the first binding's Mirror: one handle, one value, one callback and one write state.
 
 class TypeBase 
 {
+  friend class SignalBundle;
+
   // Enums
   public:
+  // IMMEDIATE : every assignment does a vpi_put_value right away.
+  // DEFERRED  : assignments only update the local value and mark the signal
+  //             dirty. All dirty signals are written once, last of the NBA
+  //             region (cbReadWriteSynch, see region_queue.h) of the timestep.
+  //             Use Flush() when the RTL must see the value right away.
+  enum class WRITE_MODE
+  {
+    IMMEDIATE,
+    DEFERRED
+  };
+  // How the local value follows the RTL.
+  // EAGER   : a value change callback imports every change (full vector copy).
+  // LAZY    : the value change callback only marks the value stale (no value
+  //           is passed); it is imported on the first read after a change.
+  // CLOCKED : no per-signal callback. The value is sampled on an edge of a
+  //           clock (see Set_SampleClock). One callback is shared by all the
+  //           signals sampled on the same clock/edge.
+  // SETTLED : every change within a timestep (i.e. delta glitches of
+  //           combinational logic) is collapsed into one: the value is read
+  //           once, first of the read-only region (cbReadOnlySynch), and
+  //           subscribers are notified only if the settled value differs
+  //           from the previous one. Until then the local value is the last
+  //           settled one. Subscribers run in the read-only region and must
+  //           not write signals.
+  enum class SAMPLE_MODE
+  {
+    EAGER,
+    LAZY,
+    CLOCKED,
+    SETTLED
+  };
 
   // Nested Classes
+  private:
+  class Mirror;
+
+  // One subscription per clock/edge (see Clock), shared by every
+  // CLOCKED signal sampled on it.
+  struct ClockSampler
+  {
+    string              clockName;
+    Clock *             clock;
+    Vpi::EDGE           edge;
+    Clock::Id           subscription;
+    vector<Mirror *>    signals;
+  };
+
+  // Everything subscribed to a signal's changes (see OnChange). Created on the
+  // first subscription; all of it is served by the signal's one value change
+  // callback, filtered there before any user code runs.
+  struct Subscribers
+  {
+    // One shot: fn runs after count matching transitions, then is dropped.
+    // edge is POSEDGE, NEGEDGE or NO_EDGE (any change).
+    struct Waiter
+    {
+      Vpi::EDGE             edge;
+      UInt32                count;
+      function<void()>      fn;
+    };
+    struct ValueWatch
+    {
+      UInt64                value;
+      bool                  once;
+      function<void()>      fn;
+    };
+
+    Event<void>             change;
+    Event<void>             posedge;
+    Event<void>             negedge;
+    vector<ValueWatch>      values;
+    vector<Waiter>          waiters;
+    Vpi::SCALAR_VAL         lastLsb;
+    BitVector *             value;    // Scratch for the value watches, nullptr until needed.
+  };
+
+  // The rtl side of a signal. One per rtl signal, reference counted
+  // by the TypeBase objects bound to it.
+  class Mirror
+  {
+    friend class TypeBase;
+
+    // Private Members
+    private:
+    string              m_nameFull;
+    NB_STATES           m_nbStates;
+    vpiHandle           m_sigHandle;
+    vpiHandle           m_callBackHandle;
+    UInt32              m_size;
+    BitVector *         m_bv;
+    Pli::VectorContext  m_xport;      // Reused for every rtl read/write (no per-access allocation).
+    WRITE_MODE          m_writeMode;
+    bool                m_dirty;      // Local value has not been written to the rtl yet.
+    SAMPLE_MODE         m_sampleMode;
+    bool                m_stale;      // LAZY only: the rtl changed since the last import.
+    ClockSampler *      m_sampler;    // CLOCKED only.
+    UInt32              m_refCount;
+    bool                m_registered; // False for a private (unshared) mirror.
+    Subscribers *       m_subs;       // nullptr until something subscribes.
+    bool                m_settlePending;  // SETTLED only: changed this timestep, in s_settleList.
+
+    // Constructors
+    public:
+    Mirror(string iFullName, NB_STATES iStates);
+    ~Mirror();
+
+    // Private Methods
+    private:
+    bool          set_Handle();
+    void          registerValChangeCB();
+    void          unregisterValChangeCB();
+    void          detachSampling();
+    void          markDirty();
+    void          read();
+    void          write();
+    Subscribers & subscribers();
+    void          dispatch(Vpi::p_vpi_value iValue);
+    static Int32  s_valueChangedCB(Vpi::t_cb_data * iData);
+  };
+
   protected:
   class PartSelect
   {
@@ -79,11 +206,11 @@ class TypeBase
     PartSelect & operator= (Int64 iRhs)                             { return *this = (UInt64)iRhs; }
     PartSelect & operator= (int iRhs)                               { return *this = (UInt32)iRhs; }
 
-    UInt32 operator[] (UInt32 iWordIndex)                     const { return         (*m_parent->m_bv)[iWordIndex]; }
-    explicit operator bool()                                  const { return   (bool)(*m_parent->m_bv); }
-    explicit operator UInt32()                                const { return (UInt32)(*m_parent->m_bv); }
-    explicit operator UInt64()                                const { return (UInt64)(*m_parent->m_bv); }
-    explicit operator BitVector()                             const { return (BitVector)((*m_parent->m_bv)(m_upperIndex, m_lowerIndex)); }
+    UInt32 operator[] (UInt32 iWordIndex)                     const { return         m_parent->get_BitVector()[iWordIndex]; }
+    explicit operator bool()                                  const { return   (bool)m_parent->get_BitVector(); }
+    explicit operator UInt32()                                const { return (UInt32)m_parent->get_BitVector(); }
+    explicit operator UInt64()                                const { return (UInt64)m_parent->get_BitVector(); }
+    explicit operator BitVector()                             const { return (BitVector)(m_parent->get_BitVector()(m_upperIndex, m_lowerIndex)); }
 
     BitVector operator+= (UInt32 iRhs);
     BitVector operator+= (UInt64 iRhs);
@@ -313,25 +440,57 @@ class TypeBase
   private:
     string                m_name;
     string                m_nameFull;
-    vpiHandle             m_sigHandle;
-    vpiHandle             m_callBackHandle;
-    UInt32                m_size;
-    BitVector *           m_bv;
-    bool                  m_maskValChange;
+    Mirror *              m_mirror;
 
-    NB_STATES             m_nbStates;
+    static WRITE_MODE             s_defaultWriteMode;
+    static vector<Mirror *>       s_dirtyList;
+    static bool                   s_flushPending;
+    static SAMPLE_MODE            s_defaultSampleMode;
+    static vector<ClockSampler *> s_samplers;
+    static vector<Mirror *>       s_settleList;
+    static bool                   s_settlePending;
+    static map<string, Mirror *>  s_registry;
 
   // Protected Properties
   protected:
-    vpiHandle   get_SigHandle() const   { return m_sigHandle; }
-    BitVector & get_BitVector() const   { return *m_bv; };
-    void        set_Size(UInt32 iSize)  { m_size = iSize; }
+    vpiHandle   get_SigHandle() const   { return m_mirror->m_sigHandle; }
+    BitVector & get_BitVector() const   { if(m_mirror->m_stale) { m_mirror->read(); } return *m_mirror->m_bv; };
+    bool        get_Shared() const      { return m_mirror->m_bv != nullptr; }
+    // A shared binding of another size gets a mirror of its own.
+    void        set_Size(UInt32 iSize);
 
   // Public Properties
+  // The write/sample modes belong to the rtl signal, so setting
+  // them affects every binding of it.
   public:
     string      Get_Name() const      { return m_name; }
     string      Get_NameFull() const  { return m_nameFull; }
-    UInt32      Get_Size() const      { return m_size; }
+    UInt32      Get_Size() const      { return m_mirror->m_size; }
+    UInt32      Get_BindCount() const { return m_mirror->m_refCount; }
+    bool        Get_Dirty() const     { return m_mirror->m_dirty; }
+    WRITE_MODE  Get_WriteMode() const { return m_mirror->m_writeMode; }
+    void        Set_WriteMode(WRITE_MODE iMode);
+
+    SAMPLE_MODE Get_SampleMode() const  { return m_mirror->m_sampleMode; }
+    void        Set_SampleMode(SAMPLE_MODE iMode);
+    bool        Set_SampleClock(string iClockName, Vpi::EDGE iEdge = Vpi::EDGE::POSEDGE);
+
+    // Change subscriptions. Edges follow bit 0 of the signal.
+    //   l_valid.OnPosedge() += [&]() { ... };
+    //   l_clk.WaitPosedge(4, [&]() { ... });   // Once, on the 4th rising edge.
+    Event<void> & OnChange()            { return m_mirror->subscribers().change; }
+    Event<void> & OnPosedge()           { return m_mirror->subscribers().posedge; }
+    Event<void> & OnNegedge()           { return m_mirror->subscribers().negedge; }
+    void          OnValue(UInt64 iValue, function<void()> iFn);
+    void          WaitChange(UInt32 iCount, function<void()> iFn)   { addWaiter(Vpi::EDGE::NO_EDGE, iCount, iFn); }
+    void          WaitPosedge(UInt32 iCount, function<void()> iFn)  { addWaiter(Vpi::EDGE::POSEDGE, iCount, iFn); }
+    void          WaitNegedge(UInt32 iCount, function<void()> iFn)  { addWaiter(Vpi::EDGE::NEGEDGE, iCount, iFn); }
+    void          WaitValue(UInt64 iValue, function<void()> iFn);
+
+    static WRITE_MODE   Get_DefaultWriteMode()                    { return s_defaultWriteMode; }
+    static void         Set_DefaultWriteMode(WRITE_MODE iMode)    { s_defaultWriteMode = iMode; }
+    static SAMPLE_MODE  Get_DefaultSampleMode()                   { return s_defaultSampleMode; }
+    static void         Set_DefaultSampleMode(SAMPLE_MODE iMode);
 
   // Constructors
   public:
@@ -347,18 +506,36 @@ class TypeBase
     BitVector Get_Value();
     string    ToString() const;
     void      Print() const;
+    void      Flush();
+
+    // Scheduled writes: the rtl takes the value iDelay simulation ticks (time
+    // precision units) from now. The local value follows through the value
+    // change callback when the event matures. Only variables (reg/integer)
+    // accept a delayed put.
+    //   INERTIAL_DELAY       : drops every write still pending on the signal.
+    //   TRANSPORT_DELAY      : drops pending writes scheduled after this one.
+    //   PURE_TRANSPORT_DELAY : drops nothing (spelled PURE_TRANSPORT_DLEAY in vpi.h).
+    void      Schedule(UInt64 iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode = Vpi::DELAY_MODE::INERTIAL_DELAY);
+    void      Schedule(const BitVector & iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode = Vpi::DELAY_MODE::INERTIAL_DELAY);
+    // Queues a whole waveform in one call: iValues[ii] at iStart + ii * iPeriod.
+    // Uses transport delay so the steps don't cancel each other.
+    void      ScheduleWave(const vector<UInt64> & iValues, UInt64 iPeriod, UInt64 iStart = 0);
+    void      ScheduleWave(const vector<BitVector> & iValues, UInt64 iPeriod, UInt64 iStart = 0);
+
+    static void FlushAll();
 
   // Private Methods
   private:
-    void          registerValChangeCB();
-    void          unregisterValChangeCB();
-    Int32         valueChangedCB(Vpi::t_cb_data * iData);
-    static  Int32 s_valueChangedCB(Vpi::t_cb_data * iData);
+    static  void  flush();
+    static  ClockSampler * getSampler(string iClockName, Vpi::EDGE iEdge);
+    static  void  sample(ClockSampler * iSampler);
+    static  void  settle();
+    void          schedule(const BitVector & iValue, UInt64 iDelay, Vpi::DELAY_MODE iMode);
+    void          addWaiter(Vpi::EDGE iEdge, UInt32 iCount, function<void()> iFn);
 
   // Protected Methods
   protected:
     virtual void set_Size() = 0;
-    bool set_Handle();
     void createBV();
     void get_RtlValue();
     void set_RtlValue();
@@ -366,28 +543,28 @@ class TypeBase
   // Operators
   public:
     TypeBase::PartSelect operator() (UInt32 iUpperIndex, UInt32 iLowerIndex);
-    UInt32 operator[] (UInt32 iWordIndex)                       const { return         (*m_bv)[iWordIndex]; }
-    explicit operator bool()                                    const { return   (bool)(*m_bv); }
-    explicit operator UInt32()                                  const { return (UInt32)(*m_bv); }
-    explicit operator UInt64()                                  const { return (UInt64)(*m_bv); }
-    explicit operator BitVector()                               const { return *m_bv; }
-
-    TypeBase & operator+= (UInt32 iRhs)                               { (*m_bv) += iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator+= (UInt64 iRhs)                               { (*m_bv) += iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator+= (const BitVector & iRhs)                    { (*m_bv) += iRhs; set_RtlValue(); return *this; }
+    UInt32 operator[] (UInt32 iWordIndex)                       const { return         get_BitVector()[iWordIndex]; }
+    explicit operator bool()                                    const { return   (bool)get_BitVector(); }
+    explicit operator UInt32()                                  const { return (UInt32)get_BitVector(); }
+    explicit operator UInt64()                                  const { return (UInt64)get_BitVector(); }
+    explicit operator BitVector()                               const { return get_BitVector(); }
+
+    TypeBase & operator+= (UInt32 iRhs)                               { get_BitVector() += iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator+= (UInt64 iRhs)                               { get_BitVector() += iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator+= (const BitVector & iRhs)                    { get_BitVector() += iRhs; set_RtlValue(); return *this; }
     TypeBase & operator+= (const BitVector::PartSelect & iRhs)        { return *this += (BitVector)iRhs; }
-    TypeBase & operator+= (const TypeBase & iRhs)                     { (*m_bv) += (*iRhs.m_bv); set_RtlValue(); return *this; }
+    TypeBase & operator+= (const TypeBase & iRhs)                     { get_BitVector() += iRhs.get_BitVector(); set_RtlValue(); return *this; }
     TypeBase & operator+= (const TypeBase::PartSelect & iRhs)         { return *this += (BitVector)iRhs; }
     TypeBase & operator+= (long long unsigned int iRhs)               { return *this += (UInt64)iRhs; }
     TypeBase & operator+= (long long int iRhs)                        { return *this += (UInt64)iRhs; }
     TypeBase & operator+= (Int64 iRhs)                                { return *this += (UInt64)iRhs; }
     TypeBase & operator+= (int iRhs)                                  { return *this += (UInt32)iRhs; }
 
-    BitVector  operator+  (UInt32 iRhs)                         const { return (*m_bv) + iRhs; }
-    BitVector  operator+  (UInt64 iRhs)                         const { return (*m_bv) + iRhs; }
-    BitVector  operator+  (const BitVector & iRhs)              const { return (*m_bv) + iRhs; }
+    BitVector  operator+  (UInt32 iRhs)                         const { return get_BitVector() + iRhs; }
+    BitVector  operator+  (UInt64 iRhs)                         const { return get_BitVector() + iRhs; }
+    BitVector  operator+  (const BitVector & iRhs)              const { return get_BitVector() + iRhs; }
     BitVector  operator+  (const BitVector::PartSelect & iRhs)  const { return *this + (BitVector)iRhs; }
-    BitVector  operator+  (const TypeBase & iRhs)               const { return (*m_bv) + (*iRhs.m_bv); }
+    BitVector  operator+  (const TypeBase & iRhs)               const { return get_BitVector() + iRhs.get_BitVector(); }
     BitVector  operator+  (const TypeBase::PartSelect & iRhs)   const { return *this + (BitVector)iRhs; }
     BitVector  operator+  (long long unsigned int iRhs)         const { return *this + (UInt64)iRhs; }
     BitVector  operator+  (long long int iRhs)                  const { return *this + (UInt64)iRhs; }
@@ -397,22 +574,22 @@ class TypeBase
     TypeBase & operator++ ()                                          { return *this += 1; }
     TypeBase & operator++ (int iDummy)                                { return *this += 1; }
 
-    TypeBase & operator-= (UInt32 iRhs)                               { (*m_bv) -= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator-= (UInt64 iRhs)                               { (*m_bv) -= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator-= (const BitVector & iRhs)                    { (*m_bv) -= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator-= (UInt32 iRhs)                               { get_BitVector() -= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator-= (UInt64 iRhs)                               { get_BitVector() -= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator-= (const BitVector & iRhs)                    { get_BitVector() -= iRhs; set_RtlValue(); return *this; }
     TypeBase & operator-= (const BitVector::PartSelect & iRhs)        { return *this -= (BitVector)iRhs; }
-    TypeBase & operator-= (const TypeBase & iRhs)                     { (*m_bv) -= (*iRhs.m_bv); set_RtlValue(); return *this; }
+    TypeBase & operator-= (const TypeBase & iRhs)                     { get_BitVector() -= iRhs.get_BitVector(); set_RtlValue(); return *this; }
     TypeBase & operator-= (const TypeBase::PartSelect & iRhs)         { return *this -= (BitVector)iRhs; }
     TypeBase & operator-= (long long unsigned int iRhs)               { return *this -= (UInt64)iRhs; }
     TypeBase & operator-= (long long int iRhs)                        { return *this -= (UInt64)iRhs; }
     TypeBase & operator-= (Int64 iRhs)                                { return *this -= (UInt64)iRhs; }
     TypeBase & operator-= (int iRhs)                                  { return *this -= (UInt32)iRhs; }
 
-    BitVector  operator-  (UInt32 iRhs)                         const { return *m_bv - iRhs; }
-    BitVector  operator-  (UInt64 iRhs)                         const { return *m_bv - iRhs; }
-    BitVector  operator-  (const BitVector & iRhs)              const { return *m_bv - iRhs; }
+    BitVector  operator-  (UInt32 iRhs)                         const { return get_BitVector() - iRhs; }
+    BitVector  operator-  (UInt64 iRhs)                         const { return get_BitVector() - iRhs; }
+    BitVector  operator-  (const BitVector & iRhs)              const { return get_BitVector() - iRhs; }
     BitVector  operator-  (const BitVector::PartSelect & iRhs)  const { return *this - (BitVector)iRhs; }
-    BitVector  operator-  (const TypeBase & iRhs)               const { return *m_bv - *iRhs.m_bv; }
+    BitVector  operator-  (const TypeBase & iRhs)               const { return get_BitVector() - iRhs.get_BitVector(); }
     BitVector  operator-  (const TypeBase::PartSelect & iRhs)   const { return *this - (BitVector)iRhs; }
     BitVector  operator-  (long long unsigned int iRhs)         const { return *this - (UInt64)iRhs; }
     BitVector  operator-  (long long int iRhs)                  const { return *this - (UInt64)iRhs; }
@@ -422,173 +599,173 @@ class TypeBase
     TypeBase & operator-- ()                                          { return *this -= 1; }
     TypeBase & operator-- (int iDummy)                                { return *this -= 1; }
 
-    bool operator== (UInt32 iRhs)                               const { return *m_bv == iRhs; }
-    bool operator== (UInt64 iRhs)                               const { return *m_bv == iRhs; }
-    bool operator== (const BitVector & iRhs)                    const { return *m_bv == iRhs; }
+    bool operator== (UInt32 iRhs)                               const { return get_BitVector() == iRhs; }
+    bool operator== (UInt64 iRhs)                               const { return get_BitVector() == iRhs; }
+    bool operator== (const BitVector & iRhs)                    const { return get_BitVector() == iRhs; }
     bool operator== (const BitVector::PartSelect & iRhs)        const { return *this == (BitVector)iRhs; }
-    bool operator== (const TypeBase & iRhs)                     const { return *m_bv == *iRhs.m_bv; }
+    bool operator== (const TypeBase & iRhs)                     const { return get_BitVector() == iRhs.get_BitVector(); }
     bool operator== (const TypeBase::PartSelect & iRhs)         const { return *this == (BitVector)iRhs; }
     bool operator== (long long unsigned int iRhs)               const { return *this == (UInt64)iRhs; }
     bool operator== (long long int iRhs)                        const { return *this == (UInt64)iRhs; }
     bool operator== (Int64 iRhs)                                const { return *this == (UInt64)iRhs; }
     bool operator== (int iRhs)                                  const { return *this == (UInt32)iRhs; }
 
-    bool operator!= (UInt32 iRhs)                               const { return !(*m_bv == iRhs); }
-    bool operator!= (UInt64 iRhs)                               const { return !(*m_bv == iRhs); }
-    bool operator!= (const BitVector & iRhs)                    const { return !(*m_bv == iRhs); }
+    bool operator!= (UInt32 iRhs)                               const { return !(get_BitVector() == iRhs); }
+    bool operator!= (UInt64 iRhs)                               const { return !(get_BitVector() == iRhs); }
+    bool operator!= (const BitVector & iRhs)                    const { return !(get_BitVector() == iRhs); }
     bool operator!= (const BitVector::PartSelect & iRhs)        const { return  (*this != (BitVector)iRhs); }
-    bool operator!= (const TypeBase & iRhs)                     const { return  (*m_bv != *iRhs.m_bv); }
+    bool operator!= (const TypeBase & iRhs)                     const { return  (get_BitVector() != iRhs.get_BitVector()); }
     bool operator!= (const TypeBase::PartSelect & iRhs)         const { return  (*this != (BitVector)iRhs); }
     bool operator!= (long long unsigned int iRhs)               const { return  (*this != (UInt64)iRhs); }
     bool operator!= (long long int iRhs)                        const { return  (*this != (UInt64)iRhs); }
     bool operator!= (Int64 iRhs)                                const { return  (*this != (UInt64)iRhs); }
     bool operator!= (int iRhs)                                  const { return  (*this != (UInt32)iRhs); }
 
-    bool operator<= (UInt32 iRhs)                               const { return *m_bv <= iRhs; }
-    bool operator<= (UInt64 iRhs)                               const { return *m_bv <= iRhs; }
-    bool operator<= (const BitVector & iRhs)                    const { return *m_bv <= iRhs; }
+    bool operator<= (UInt32 iRhs)                               const { return get_BitVector() <= iRhs; }
+    bool operator<= (UInt64 iRhs)                               const { return get_BitVector() <= iRhs; }
+    bool operator<= (const BitVector & iRhs)                    const { return get_BitVector() <= iRhs; }
     bool operator<= (const BitVector::PartSelect & iRhs)        const { return *this <= (BitVector)iRhs; }
-    bool operator<= (const TypeBase & iRhs)                     const { return *m_bv <= *iRhs.m_bv; }
+    bool operator<= (const TypeBase & iRhs)                     const { return get_BitVector() <= iRhs.get_BitVector(); }
     bool operator<= (const TypeBase::PartSelect & iRhs)         const { return *this <= (BitVector)iRhs; }
     bool operator<= (long long unsigned int iRhs)               const { return *this <= (UInt64)iRhs; }
     bool operator<= (long long int iRhs)                        const { return *this <= (UInt64)iRhs; }
     bool operator<= (Int64 iRhs)                                const { return *this <= (UInt64)iRhs; }
     bool operator<= (int iRhs)                                  const { return *this <= (UInt32)iRhs; }
 
-    bool operator>= (UInt32 iRhs)                               const { return *m_bv >= iRhs; }
-    bool operator>= (UInt64 iRhs)                               const { return *m_bv >= iRhs; }
-    bool operator>= (const BitVector & iRhs)                    const { return *m_bv >= iRhs; }
+    bool operator>= (UInt32 iRhs)                               const { return get_BitVector() >= iRhs; }
+    bool operator>= (UInt64 iRhs)                               const { return get_BitVector() >= iRhs; }
+    bool operator>= (const BitVector & iRhs)                    const { return get_BitVector() >= iRhs; }
     bool operator>= (const BitVector::PartSelect & iRhs)        const { return *this >= (BitVector)iRhs; }
-    bool operator>= (const TypeBase & iRhs)                     const { return *m_bv >= *iRhs.m_bv; }
+    bool operator>= (const TypeBase & iRhs)                     const { return get_BitVector() >= iRhs.get_BitVector(); }
     bool operator>= (const TypeBase::PartSelect & iRhs)         const { return *this >= (BitVector)iRhs; }
     bool operator>= (long long unsigned int iRhs)               const { return *this >= (UInt64)iRhs; }
     bool operator>= (long long int iRhs)                        const { return *this >= (UInt64)iRhs; }
     bool operator>= (Int64 iRhs)                                const { return *this >= (UInt64)iRhs; }
     bool operator>= (int iRhs)                                  const { return *this >= (UInt32)iRhs; }
 
-    bool operator>  (UInt32 iRhs)                               const { return *m_bv > iRhs; }
-    bool operator>  (UInt64 iRhs)                               const { return *m_bv > iRhs; }
-    bool operator>  (const BitVector & iRhs)                    const { return *m_bv > iRhs; }
+    bool operator>  (UInt32 iRhs)                               const { return get_BitVector() > iRhs; }
+    bool operator>  (UInt64 iRhs)                               const { return get_BitVector() > iRhs; }
+    bool operator>  (const BitVector & iRhs)                    const { return get_BitVector() > iRhs; }
     bool operator>  (const BitVector::PartSelect & iRhs)        const { return *this > (BitVector)iRhs; }
-    bool operator>  (const TypeBase & iRhs)                     const { return *m_bv > *iRhs.m_bv; }
+    bool operator>  (const TypeBase & iRhs)                     const { return get_BitVector() > iRhs.get_BitVector(); }
     bool operator>  (const TypeBase::PartSelect & iRhs)         const { return *this > (BitVector)iRhs; }
     bool operator>  (long long unsigned int iRhs)               const { return *this > (UInt64)iRhs; }
     bool operator>  (long long int iRhs)                        const { return *this > (UInt64)iRhs; }
     bool operator>  (Int64 iRhs)                                const { return *this > (UInt64)iRhs; }
     bool operator>  (int iRhs)                                  const { return *this > (UInt32)iRhs; }
 
-    bool operator<  (UInt32 iRhs)                               const { return *m_bv < iRhs; }
-    bool operator<  (UInt64 iRhs)                               const { return *m_bv < iRhs; }
-    bool operator<  (const BitVector & iRhs)                    const { return *m_bv < iRhs; }
+    bool operator<  (UInt32 iRhs)                               const { return get_BitVector() < iRhs; }
+    bool operator<  (UInt64 iRhs)                               const { return get_BitVector() < iRhs; }
+    bool operator<  (const BitVector & iRhs)                    const { return get_BitVector() < iRhs; }
     bool operator<  (const BitVector::PartSelect & iRhs)        const { return *this < (BitVector)iRhs; }
-    bool operator<  (const TypeBase & iRhs)                     const { return *m_bv < *iRhs.m_bv; }
+    bool operator<  (const TypeBase & iRhs)                     const { return get_BitVector() < iRhs.get_BitVector(); }
     bool operator<  (const TypeBase::PartSelect & iRhs)         const { return *this < (BitVector)iRhs; }
     bool operator<  (long long unsigned int iRhs)               const { return *this < (UInt64)iRhs; }
     bool operator<  (long long int iRhs)                        const { return *this < (UInt64)iRhs; }
     bool operator<  (Int64 iRhs)                                const { return *this < (UInt64)iRhs; }
     bool operator<  (int iRhs)                                  const { return *this < (UInt32)iRhs; }
 
-    TypeBase & operator<<= (UInt32 iRhs)                              { *m_bv <<= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator<<= (const BitVector & iRhs)                   { *m_bv <<= iRhs[0]; set_RtlValue(); return *this; }
-    TypeBase & operator<<= (const BitVector::PartSelect & iRhs)       { *m_bv <<= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator<<= (const TypeBase & iRhs)                    { *m_bv <<= (UInt32)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator<<= (const TypeBase::PartSelect & iRhs)        { *m_bv <<= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator<<= (int iRhs)                                 { *m_bv <<= (UInt32)iRhs; set_RtlValue(); return *this; }
-
-    TypeBase & operator>>= (UInt32 iRhs)                              { *m_bv >>= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator>>= (const BitVector & iRhs)                   { *m_bv >>= iRhs[0]; set_RtlValue(); return *this; }
-    TypeBase & operator>>= (const BitVector::PartSelect & iRhs)       { *m_bv >>= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator>>= (const TypeBase & iRhs)                    { *m_bv >>= (UInt32)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator>>= (const TypeBase::PartSelect & iRhs)        { *m_bv >>= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator>>= (int iRhs)                                 { *m_bv >>= (UInt32)iRhs; set_RtlValue(); return *this; }
-
-    BitVector  operator<< (UInt32 iRhs)                         const { return *m_bv << iRhs; }
-    BitVector  operator<< (const BitVector & iRhs)              const { return *m_bv << iRhs[0]; }
-    BitVector  operator<< (const BitVector::PartSelect & iRhs)  const { return *m_bv << ((BitVector)iRhs)[0]; }
-    BitVector  operator<< (const TypeBase & iRhs)               const { return *m_bv << (UInt32)iRhs; }
-    BitVector  operator<< (const TypeBase::PartSelect & iRhs)   const { return *m_bv << ((BitVector)iRhs)[0]; }
-    BitVector  operator<< (int iRhs)                            const { return *m_bv << (UInt32)iRhs; }
-
-    BitVector  operator>> (UInt32 iRhs)                         const { return *m_bv >> iRhs; }
-    BitVector  operator>> (const BitVector & iRhs)              const { return *m_bv >> iRhs[0]; }
-    BitVector  operator>> (const BitVector::PartSelect & iRhs)  const { return *m_bv >> ((BitVector)iRhs)[0]; }
-    BitVector  operator>> (const TypeBase & iRhs)               const { return *m_bv >> (UInt32)iRhs; }
-    BitVector  operator>> (const TypeBase::PartSelect & iRhs)   const { return *m_bv >> ((BitVector)iRhs)[0]; }
-    BitVector  operator>> (int iRhs)                            const { return *m_bv >> (UInt32)iRhs; }
-
-    BitVector  operator~  ()                                    const { return ~(*m_bv); }
-
-    TypeBase & operator&= (UInt32 iRhs)                               { *m_bv &= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (UInt64 iRhs)                               { *m_bv &= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (const BitVector & iRhs)                    { *m_bv &= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (const BitVector::PartSelect & iRhs)        { *m_bv &= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (const TypeBase & iRhs)                     { *m_bv &= *iRhs.m_bv; set_RtlValue(); return *this; }
-    TypeBase & operator&= (const TypeBase::PartSelect & iRhs)         { *m_bv &= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (long long unsigned int iRhs)               { *m_bv &= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (long long int iRhs)                        { *m_bv &= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (Int64 iRhs)                                { *m_bv &= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator&= (int iRhs)                                  { *m_bv &= (UInt32)iRhs; set_RtlValue(); return *this; }
-
-    BitVector  operator&  (UInt32 iRhs)                         const { return *m_bv & iRhs; }
-    BitVector  operator&  (UInt64 iRhs)                         const { return *m_bv & iRhs; }
-    BitVector  operator&  (const BitVector & iRhs)              const { return *m_bv & iRhs; }
-    BitVector  operator&  (const BitVector::PartSelect & iRhs)  const { return *m_bv & ((BitVector)iRhs); }
-    BitVector  operator&  (const TypeBase & iRhs)               const { return *m_bv & *iRhs.m_bv; }
-    BitVector  operator&  (const TypeBase::PartSelect & iRhs)   const { return *m_bv & ((BitVector)iRhs); }
-    BitVector  operator&  (long long unsigned int iRhs)         const { return *m_bv & (UInt64)iRhs; }
-    BitVector  operator&  (long long int iRhs)                  const { return *m_bv & (UInt64)iRhs; }
-    BitVector  operator&  (Int64 iRhs)                          const { return *m_bv & (UInt64)iRhs; }
-    BitVector  operator&  (int iRhs)                            const { return *m_bv & (UInt32)iRhs; }
-
-    TypeBase & operator|= (UInt32 iRhs)                               { *m_bv |= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (UInt64 iRhs)                               { *m_bv |= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (const BitVector & iRhs)                    { *m_bv |= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (const BitVector::PartSelect & iRhs)        { *m_bv |= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (const TypeBase & iRhs)                     { *m_bv |= *iRhs.m_bv; set_RtlValue(); return *this; }
-    TypeBase & operator|= (const TypeBase::PartSelect & iRhs)         { *m_bv |= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (long long unsigned int iRhs)               { *m_bv |= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (long long int iRhs)                        { *m_bv |= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (Int64 iRhs)                                { *m_bv |= (UInt64)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator|= (int iRhs)                                  { *m_bv |= (UInt32)iRhs; set_RtlValue(); return *this; }
-
-    BitVector  operator|  (UInt32 iRhs)                         const { return *m_bv | iRhs; }
-    BitVector  operator|  (UInt64 iRhs)                         const { return *m_bv | iRhs; }
-    BitVector  operator|  (const BitVector & iRhs)              const { return *m_bv | iRhs; }
-    BitVector  operator|  (const BitVector::PartSelect & iRhs)  const { return *m_bv | ((BitVector)iRhs); }
-    BitVector  operator|  (const TypeBase & iRhs)               const { return *m_bv | *iRhs.m_bv; }
-    BitVector  operator|  (const TypeBase::PartSelect & iRhs)   const { return *m_bv | ((BitVector)iRhs); }
-    BitVector  operator|  (long long unsigned int iRhs)         const { return *m_bv | (UInt64)iRhs; }
-    BitVector  operator|  (long long int iRhs)                  const { return *m_bv | (UInt64)iRhs; }
-    BitVector  operator|  (Int64 iRhs)                          const { return *m_bv | (UInt64)iRhs; }
-    BitVector  operator|  (int iRhs)                            const { return *m_bv | (UInt32)iRhs; }
-
-    TypeBase & operator^= (UInt32 iRhs)                               { *m_bv ^= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator^= (UInt64 iRhs)                               { *m_bv ^= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator^= (const BitVector & iRhs)                    { *m_bv ^= iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator^= (const BitVector::PartSelect & iRhs)        { *m_bv ^= (BitVector)iRhs; set_RtlValue(); return *this; }
-    TypeBase & operator^= (const TypeBase & iRhs)                     { *m_bv ^= *iRhs.m_bv; set_RtlValue(); return *this; }
-    TypeBase & operator^= (const TypeBase::PartSelect & iRhs)         { *m_bv ^= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (UInt32 iRhs)                              { get_BitVector() <<= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (const BitVector & iRhs)                   { get_BitVector() <<= iRhs[0]; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (const BitVector::PartSelect & iRhs)       { get_BitVector() <<= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (const TypeBase & iRhs)                    { get_BitVector() <<= (UInt32)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (const TypeBase::PartSelect & iRhs)        { get_BitVector() <<= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator<<= (int iRhs)                                 { get_BitVector() <<= (UInt32)iRhs; set_RtlValue(); return *this; }
+
+    TypeBase & operator>>= (UInt32 iRhs)                              { get_BitVector() >>= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator>>= (const BitVector & iRhs)                   { get_BitVector() >>= iRhs[0]; set_RtlValue(); return *this; }
+    TypeBase & operator>>= (const BitVector::PartSelect & iRhs)       { get_BitVector() >>= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator>>= (const TypeBase & iRhs)                    { get_BitVector() >>= (UInt32)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator>>= (const TypeBase::PartSelect & iRhs)        { get_BitVector() >>= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator>>= (int iRhs)                                 { get_BitVector() >>= (UInt32)iRhs; set_RtlValue(); return *this; }
+
+    BitVector  operator<< (UInt32 iRhs)                         const { return get_BitVector() << iRhs; }
+    BitVector  operator<< (const BitVector & iRhs)              const { return get_BitVector() << iRhs[0]; }
+    BitVector  operator<< (const BitVector::PartSelect & iRhs)  const { return get_BitVector() << ((BitVector)iRhs)[0]; }
+    BitVector  operator<< (const TypeBase & iRhs)               const { return get_BitVector() << (UInt32)iRhs; }
+    BitVector  operator<< (const TypeBase::PartSelect & iRhs)   const { return get_BitVector() << ((BitVector)iRhs)[0]; }
+    BitVector  operator<< (int iRhs)                            const { return get_BitVector() << (UInt32)iRhs; }
+
+    BitVector  operator>> (UInt32 iRhs)                         const { return get_BitVector() >> iRhs; }
+    BitVector  operator>> (const BitVector & iRhs)              const { return get_BitVector() >> iRhs[0]; }
+    BitVector  operator>> (const BitVector::PartSelect & iRhs)  const { return get_BitVector() >> ((BitVector)iRhs)[0]; }
+    BitVector  operator>> (const TypeBase & iRhs)               const { return get_BitVector() >> (UInt32)iRhs; }
+    BitVector  operator>> (const TypeBase::PartSelect & iRhs)   const { return get_BitVector() >> ((BitVector)iRhs)[0]; }
+    BitVector  operator>> (int iRhs)                            const { return get_BitVector() >> (UInt32)iRhs; }
+
+    BitVector  operator~  ()                                    const { return ~get_BitVector(); }
+
+    TypeBase & operator&= (UInt32 iRhs)                               { get_BitVector() &= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (UInt64 iRhs)                               { get_BitVector() &= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (const BitVector & iRhs)                    { get_BitVector() &= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (const BitVector::PartSelect & iRhs)        { get_BitVector() &= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (const TypeBase & iRhs)                     { get_BitVector() &= iRhs.get_BitVector(); set_RtlValue(); return *this; }
+    TypeBase & operator&= (const TypeBase::PartSelect & iRhs)         { get_BitVector() &= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (long long unsigned int iRhs)               { get_BitVector() &= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (long long int iRhs)                        { get_BitVector() &= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (Int64 iRhs)                                { get_BitVector() &= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator&= (int iRhs)                                  { get_BitVector() &= (UInt32)iRhs; set_RtlValue(); return *this; }
+
+    BitVector  operator&  (UInt32 iRhs)                         const { return get_BitVector() & iRhs; }
+    BitVector  operator&  (UInt64 iRhs)                         const { return get_BitVector() & iRhs; }
+    BitVector  operator&  (const BitVector & iRhs)              const { return get_BitVector() & iRhs; }
+    BitVector  operator&  (const BitVector::PartSelect & iRhs)  const { return get_BitVector() & ((BitVector)iRhs); }
+    BitVector  operator&  (const TypeBase & iRhs)               const { return get_BitVector() & iRhs.get_BitVector(); }
+    BitVector  operator&  (const TypeBase::PartSelect & iRhs)   const { return get_BitVector() & ((BitVector)iRhs); }
+    BitVector  operator&  (long long unsigned int iRhs)         const { return get_BitVector() & (UInt64)iRhs; }
+    BitVector  operator&  (long long int iRhs)                  const { return get_BitVector() & (UInt64)iRhs; }
+    BitVector  operator&  (Int64 iRhs)                          const { return get_BitVector() & (UInt64)iRhs; }
+    BitVector  operator&  (int iRhs)                            const { return get_BitVector() & (UInt32)iRhs; }
+
+    TypeBase & operator|= (UInt32 iRhs)                               { get_BitVector() |= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (UInt64 iRhs)                               { get_BitVector() |= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (const BitVector & iRhs)                    { get_BitVector() |= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (const BitVector::PartSelect & iRhs)        { get_BitVector() |= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (const TypeBase & iRhs)                     { get_BitVector() |= iRhs.get_BitVector(); set_RtlValue(); return *this; }
+    TypeBase & operator|= (const TypeBase::PartSelect & iRhs)         { get_BitVector() |= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (long long unsigned int iRhs)               { get_BitVector() |= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (long long int iRhs)                        { get_BitVector() |= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (Int64 iRhs)                                { get_BitVector() |= (UInt64)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator|= (int iRhs)                                  { get_BitVector() |= (UInt32)iRhs; set_RtlValue(); return *this; }
+
+    BitVector  operator|  (UInt32 iRhs)                         const { return get_BitVector() | iRhs; }
+    BitVector  operator|  (UInt64 iRhs)                         const { return get_BitVector() | iRhs; }
+    BitVector  operator|  (const BitVector & iRhs)              const { return get_BitVector() | iRhs; }
+    BitVector  operator|  (const BitVector::PartSelect & iRhs)  const { return get_BitVector() | ((BitVector)iRhs); }
+    BitVector  operator|  (const TypeBase & iRhs)               const { return get_BitVector() | iRhs.get_BitVector(); }
+    BitVector  operator|  (const TypeBase::PartSelect & iRhs)   const { return get_BitVector() | ((BitVector)iRhs); }
+    BitVector  operator|  (long long unsigned int iRhs)         const { return get_BitVector() | (UInt64)iRhs; }
+    BitVector  operator|  (long long int iRhs)                  const { return get_BitVector() | (UInt64)iRhs; }
+    BitVector  operator|  (Int64 iRhs)                          const { return get_BitVector() | (UInt64)iRhs; }
+    BitVector  operator|  (int iRhs)                            const { return get_BitVector() | (UInt32)iRhs; }
+
+    TypeBase & operator^= (UInt32 iRhs)                               { get_BitVector() ^= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator^= (UInt64 iRhs)                               { get_BitVector() ^= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator^= (const BitVector & iRhs)                    { get_BitVector() ^= iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator^= (const BitVector::PartSelect & iRhs)        { get_BitVector() ^= (BitVector)iRhs; set_RtlValue(); return *this; }
+    TypeBase & operator^= (const TypeBase & iRhs)                     { get_BitVector() ^= iRhs.get_BitVector(); set_RtlValue(); return *this; }
+    TypeBase & operator^= (const TypeBase::PartSelect & iRhs)         { get_BitVector() ^= (BitVector)iRhs; set_RtlValue(); return *this; }
     TypeBase & operator^= (long long unsigned int iRhs)               { return *this ^= (UInt64)iRhs; }
     TypeBase & operator^= (long long int iRhs)                        { return *this ^= (UInt64)iRhs; }
     TypeBase & operator^= (Int64 iRhs)                                { return *this ^= (UInt64)iRhs; }
     TypeBase & operator^= (int iRhs)                                  { return *this ^= (UInt32)iRhs; }
 
-    BitVector  operator^  (UInt32 iRhs)                         const { return *m_bv ^ iRhs; }
-    BitVector  operator^  (UInt64 iRhs)                         const { return *m_bv ^ iRhs; }
-    BitVector  operator^  (const BitVector & iRhs)              const { return *m_bv ^ iRhs; }
-    BitVector  operator^  (const BitVector::PartSelect & iRhs)  const { return *m_bv ^ ((BitVector)iRhs); }
-    BitVector  operator^  (const TypeBase & iRhs)               const { return *m_bv ^ *iRhs.m_bv; }
-    BitVector  operator^  (const TypeBase::PartSelect & iRhs)   const { return *m_bv ^ ((BitVector)iRhs); }
-    BitVector  operator^  (long long unsigned int iRhs)         const { return *m_bv ^ (UInt64)iRhs; }
-    BitVector  operator^  (long long int iRhs)                  const { return *m_bv ^ (UInt64)iRhs; }
-    BitVector  operator^  (Int64 iRhs)                          const { return *m_bv ^ (UInt64)iRhs; }
-    BitVector  operator^  (int iRhs)                            const { return *m_bv ^ (UInt32)iRhs; }
-
-    BitVector  operator,  (UInt32 iRhs)                         const { return (*m_bv , iRhs); }
-    BitVector  operator,  (UInt64 iRhs)                         const { return (*m_bv , iRhs); }
-    BitVector  operator,  (const BitVector & iRhs)              const { return (*m_bv , iRhs); }
+    BitVector  operator^  (UInt32 iRhs)                         const { return get_BitVector() ^ iRhs; }
+    BitVector  operator^  (UInt64 iRhs)                         const { return get_BitVector() ^ iRhs; }
+    BitVector  operator^  (const BitVector & iRhs)              const { return get_BitVector() ^ iRhs; }
+    BitVector  operator^  (const BitVector::PartSelect & iRhs)  const { return get_BitVector() ^ ((BitVector)iRhs); }
+    BitVector  operator^  (const TypeBase & iRhs)               const { return get_BitVector() ^ iRhs.get_BitVector(); }
+    BitVector  operator^  (const TypeBase::PartSelect & iRhs)   const { return get_BitVector() ^ ((BitVector)iRhs); }
+    BitVector  operator^  (long long unsigned int iRhs)         const { return get_BitVector() ^ (UInt64)iRhs; }
+    BitVector  operator^  (long long int iRhs)                  const { return get_BitVector() ^ (UInt64)iRhs; }
+    BitVector  operator^  (Int64 iRhs)                          const { return get_BitVector() ^ (UInt64)iRhs; }
+    BitVector  operator^  (int iRhs)                            const { return get_BitVector() ^ (UInt32)iRhs; }
+
+    BitVector  operator,  (UInt32 iRhs)                         const { return (get_BitVector() , iRhs); }
+    BitVector  operator,  (UInt64 iRhs)                         const { return (get_BitVector() , iRhs); }
+    BitVector  operator,  (const BitVector & iRhs)              const { return (get_BitVector() , iRhs); }
     BitVector  operator,  (const BitVector::PartSelect & iRhs)  const { return (*this , ((BitVector)iRhs)); }
-    BitVector  operator,  (const TypeBase & iRhs)               const { return (*m_bv , *iRhs.m_bv); }
+    BitVector  operator,  (const TypeBase & iRhs)               const { return (get_BitVector() , iRhs.get_BitVector()); }
     BitVector  operator,  (const TypeBase::PartSelect & iRhs)   const { return (*this , ((BitVector)iRhs)); }
     BitVector  operator,  (long long unsigned int iRhs)         const { return (*this , (UInt64)iRhs); }
     BitVector  operator,  (long long int iRhs)                  const { return (*this , (UInt64)iRhs); }
@@ -21,6 +21,18 @@
 #                     in the event's list of delegates.
 #                     The list of delegates will be called from the first
 #                     delegate added to the last in order.
+#
+#                     += returns a token that removes the delegate again:
+#                           Event<void>::Token l_tok = _myEvent += myTestMethod;
+#                           _myEvent -= l_tok;
+#                     Delegates live in one array (the first few inside the
+#                     event itself), and a callable of up to c_inlineSize
+#                     bytes (i.e. a lambda capturing a few pointers) is
+#                     stored in place, so firing never allocates.
+#                     Removal is O(1) (the slot is emptied, the array is
+#                     compacted later). A delegate may add or remove
+#                     delegates, or fire the event again, while it runs;
+#                     delegates added during a fire first run on the next.
 #                     Example:
 #                               // Event delegate methods will return void
 #                               // and pass an Int32 and a UInt32 as params.
@@ -45,7 +57,10 @@
 #define EVENT_H
 
 #include <functional>
-#include <list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "Common.h"
 #include "Logger.h"
@@ -53,87 +68,389 @@
 template<typename RetTp, typename ...Args>
 class Event
 {
-  // Enums
+  // Constants
   public:
+    static const UInt32 c_inlineSize = 4 * sizeof(void *);
+    static const UInt32 c_inlineSlots = 4;
+
+  private:
+    static const UInt32 c_nil = 0xFFFFFFFF;
+    static const UInt32 c_addedBit = 0x80000000;   // Position in m_added, not m_data.
 
   // Nested Classes
   public:
+    // Generation in the high word, so a stale token never removes a reused slot.
+    typedef UInt64 Token;
+
+  private:
+    // A callable, stored in place when it fits, on the heap otherwise.
+    class Delegate
+    {
+      private:
+        typedef RetTp (*Invoke)(void *, Args...);
+        // Moves *iSrc into ioDst and destroys iSrc; destroys ioDst if iSrc is nullptr.
+        typedef void  (*Manage)(void * ioDst, void * iSrc);
+
+        typename aligned_storage<c_inlineSize, alignof(max_align_t)>::type m_buf;
+        Invoke  m_invoke;
+        Manage  m_manage;
+
+        template<typename Fn>
+        struct InPlace
+        {
+          static RetTp invoke(void * iBuf, Args... iArgs)
+          {
+            return static_cast<RetTp>((*(Fn *)iBuf)(iArgs...));
+          }
+          static void manage(void * ioDst, void * iSrc)
+          {
+            if(iSrc == nullptr)
+            {
+              ((Fn *)ioDst)->~Fn();
+              return;
+            }
+            new (ioDst) Fn(std::move(*(Fn *)iSrc));
+            ((Fn *)iSrc)->~Fn();
+          }
+        };
+        template<typename Fn>
+        struct OnHeap
+        {
+          static RetTp invoke(void * iBuf, Args... iArgs)
+          {
+            return static_cast<RetTp>((**(Fn **)iBuf)(iArgs...));
+          }
+          static void manage(void * ioDst, void * iSrc)
+          {
+            if(iSrc == nullptr)
+            {
+              delete *(Fn **)ioDst;
+              return;
+            }
+            *(Fn **)ioDst = *(Fn **)iSrc;
+          }
+        };
+
+        template<typename Fn, typename Src>
+        void set(Src && iFn, true_type)
+        {
+          new (&m_buf) Fn(std::forward<Src>(iFn));
+          m_invoke = &InPlace<Fn>::invoke;
+          m_manage = &InPlace<Fn>::manage;
+        }
+        template<typename Fn, typename Src>
+        void set(Src && iFn, false_type)
+        {
+          *(Fn **)&m_buf = new Fn(std::forward<Src>(iFn));
+          m_invoke = &OnHeap<Fn>::invoke;
+          m_manage = &OnHeap<Fn>::manage;
+        }
+
+      public:
+        Delegate() : m_invoke(nullptr), m_manage(nullptr) {}
+        Delegate(Delegate && ioOther) : m_invoke(ioOther.m_invoke), m_manage(ioOther.m_manage)
+        {
+          if(m_manage != nullptr)
+          {
+            m_manage(&m_buf, &ioOther.m_buf);
+            ioOther.m_invoke = nullptr;
+            ioOther.m_manage = nullptr;
+          }
+        }
+        Delegate & operator=(Delegate && ioOther)
+        {
+          if(this != &ioOther)
+          {
+            Reset();
+            m_invoke = ioOther.m_invoke;
+            m_manage = ioOther.m_manage;
+            if(m_manage != nullptr)
+            {
+              m_manage(&m_buf, &ioOther.m_buf);
+              ioOther.m_invoke = nullptr;
+              ioOther.m_manage = nullptr;
+            }
+          }
+          return *this;
+        }
+        Delegate(const Delegate &) = delete;
+        void operator=(const Delegate &) = delete;
+        ~Delegate()
+        {
+          Reset();
+        }
+
+        template<typename Fn>
+        void Set(Fn && iFn)
+        {
+          typedef typename decay<Fn>::type l_Fn;
+          Reset();
+          set<l_Fn>(std::forward<Fn>(iFn),
+                    integral_constant<bool, (sizeof(l_Fn) <= c_inlineSize) &&
+                                            (alignof(l_Fn) <= alignof(max_align_t)) &&
+                                            is_nothrow_move_constructible<l_Fn>::value>());
+        }
+        void Reset()
+        {
+          if(m_manage != nullptr)
+          {
+            m_manage(&m_buf, nullptr);
+          }
+          m_invoke = nullptr;
+          m_manage = nullptr;
+        }
+        bool Valid() const
+        {
+          return m_invoke != nullptr;
+        }
+        RetTp operator() (Args... iArgs)
+        {
+          return m_invoke(&m_buf, iArgs...);
+        }
+    };
+
+    struct Slot
+    {
+      Delegate  fn;
+      UInt32    id;     // Index in m_handles.
+      bool      live;   // False once removed, dropped by the next compaction.
+    };
+
+    // Where a token's delegate is; pos is c_nil once the token is free.
+    struct Handle
+    {
+      UInt32    pos;
+      UInt32    gen;
+    };
 
   // Private Members
   private:
-    list< function<RetTp(Args...)> > m_list;
+    Slot *          m_data;
+    UInt32          m_size;
+    UInt32          m_capacity;
+    UInt32          m_dead;
+    Slot            m_inline[c_inlineSlots];
+    vector<Slot>    m_added;      // Added while firing, appended once the fire ends.
+    vector<Handle>  m_handles;
+    vector<UInt32>  m_freeIds;
+    UInt32          m_firing;     // Fire depth, delegates can fire their own event.
 
   // Public Properties
   public:
+    // Delegates currently connected.
+    UInt32 Count_get() const { return m_size + m_added.size() - m_dead; }
 
   // Constructors
   public:
-    Event()
+    Event() : m_data(m_inline), m_size(0), m_capacity(c_inlineSlots), m_dead(0), m_firing(0)
     {
 
     }
-    Event(function<RetTp(Args...)> iFn)
+    Event(function<RetTp(Args...)> iFn) : Event()
     {
-      m_list.push_back(iFn);
+      add(std::move(iFn));
+    }
+    // m_data may point into the event itself.
+    Event(const Event &) = delete;
+    void operator=(const Event &) = delete;
+    ~Event()
+    {
+      if(m_data != m_inline)
+      {
+        delete[] m_data;
+      }
     }
-
-  // Inits
-  private:
 
   // Public Methods
   public:
+    bool Remove(Token iToken)
+    {
+      UInt32 l_id = (UInt32)iToken;
+      if((l_id >= m_handles.size()) || (m_handles[l_id].gen != (UInt32)(iToken >> 32)) ||
+         (m_handles[l_id].pos == c_nil))
+      {
+        return false;
+      }
+      UInt32 l_pos = m_handles[l_id].pos;
+      Slot & l_slot = (l_pos & c_addedBit) ? m_added[l_pos & ~c_addedBit] : m_data[l_pos];
+      // Emptied rather than erased, it may be running (or about to) in a fire.
+      l_slot.live = false;
+      m_dead++;
+      freeId(l_id);
+      if((m_firing == 0) && (m_dead * 2 > m_size))
+      {
+        compact();
+      }
+      return true;
+    }
+    void Clear()
+    {
+      for(UInt32 ii=0; ii<m_size; ii++)
+      {
+        if(m_data[ii].live)
+        {
+          m_data[ii].live = false;
+          m_dead++;
+          freeId(m_data[ii].id);
+        }
+      }
+      for(UInt32 ii=0; ii<m_added.size(); ii++)
+      {
+        if(m_added[ii].live)
+        {
+          m_added[ii].live = false;
+          m_dead++;
+          freeId(m_added[ii].id);
+        }
+      }
+      if(m_firing == 0)
+      {
+        compact();
+      }
+    }
 
   // Private Methods
   private:
-    bool add(function<RetTp(Args...)> iFn)
+    template<typename Fn>
+    Token add(Fn && iFn)
     {
-      m_list.push_back(iFn);
-    }
-    /*
-    TBD - figure out how to compare targets.
-    bool addIfNot(function<RetTp(Args...)> iFn)
-    {
-      for(typename list<function<RetTp(Args...)>>::iterator ii=m_list.begin(); ii != m_list.end(); ++ii)
+      UInt32 l_id;
+      if(m_freeIds.empty())
+      {
+        l_id = m_handles.size();
+        Handle l_handle;
+        l_handle.pos = c_nil;
+        l_handle.gen = 0;
+        m_handles.push_back(l_handle);
+      }
+      else
+      {
+        l_id = m_freeIds.back();
+        m_freeIds.pop_back();
+      }
+      Handle & l_handle = m_handles[l_id];
+      l_handle.gen++;
+
+      Slot * l_slot;
+      if(m_firing > 0)
+      {
+        // m_data can't move while a delegate in it runs.
+        m_added.push_back(Slot());
+        l_slot = &m_added.back();
+        l_handle.pos = c_addedBit | (m_added.size() - 1);
+      }
+      else
       {
-        if(*ii == iFn)
+        if(m_size == m_capacity)
         {
-          cout << "found function already in this event." << endl;
-          return false;
+          grow();
         }
+        l_slot = &m_data[m_size];
+        l_handle.pos = m_size;
+        m_size++;
       }
-      m_list.push_back(iFn);
-      cout << "did not find function, so adding it to this event." << endl;
-      return true;
+      l_slot->fn.Set(std::forward<Fn>(iFn));
+      l_slot->id = l_id;
+      l_slot->live = true;
+      return ((Token)l_handle.gen << 32) | l_id;
     }
-    */
-    bool remove(function<RetTp(Args...)> iFn)
+    void freeId(UInt32 iId)
     {
-      // TBD - After figuring out how to compare targets.
-      LOG_ERR_ENV << "Currently unsupported." << endl;
+      m_handles[iId].pos = c_nil;
+      m_freeIds.push_back(iId);
+    }
+    void grow()
+    {
+      UInt32 l_capacity = m_capacity * 2;
+      Slot * l_data = new Slot[l_capacity];
+      for(UInt32 ii=0; ii<m_size; ii++)
+      {
+        l_data[ii].fn = std::move(m_data[ii].fn);
+        l_data[ii].id = m_data[ii].id;
+        l_data[ii].live = m_data[ii].live;
+      }
+      if(m_data != m_inline)
+      {
+        delete[] m_data;
+      }
+      m_data = l_data;
+      m_capacity = l_capacity;
+    }
+    // Drops the removed slots and appends the ones added while firing, in order.
+    void compact()
+    {
+      UInt32 l_kept = 0;
+      for(UInt32 ii=0; ii<m_size; ii++)
+      {
+        if(!m_data[ii].live)
+        {
+          m_data[ii].fn.Reset();
+          continue;
+        }
+        if(l_kept != ii)
+        {
+          m_data[l_kept].fn = std::move(m_data[ii].fn);
+          m_data[l_kept].id = m_data[ii].id;
+          m_data[l_kept].live = true;
+          m_data[ii].live = false;
+        }
+        m_handles[m_data[l_kept].id].pos = l_kept;
+        l_kept++;
+      }
+      m_size = l_kept;
+      m_dead = 0;
+      for(UInt32 ii=0; ii<m_added.size(); ii++)
+      {
+        if(!m_added[ii].live)
+        {
+          continue;
+        }
+        if(m_size == m_capacity)
+        {
+          grow();
+        }
+        m_data[m_size].fn = std::move(m_added[ii].fn);
+        m_data[m_size].id = m_added[ii].id;
+        m_data[m_size].live = true;
+        m_handles[m_added[ii].id].pos = m_size;
+        m_size++;
+      }
+      m_added.clear();
     }
     void fire(Args... iArgs)
     {
-      for(typename list<function<RetTp(Args...)>>::iterator ii=m_list.begin(); ii != m_list.end(); ++ii)
+      m_firing++;
+      // Only the delegates connected when the fire started run.
+      UInt32 l_size = m_size;
+      for(UInt32 ii=0; ii<l_size; ii++)
       {
-        if(*ii)
+        if(m_data[ii].live)
         {
-          (*ii)(iArgs...);
+          m_data[ii].fn(iArgs...);
         }
       }
+      m_firing--;
+      if((m_firing == 0) && (!m_added.empty() || (m_dead * 2 > m_size)))
+      {
+        compact();
+      }
     }
 
   // Operators
   public:
-    //PartSelect operator() (UInt32 iUpperIndex, UInt32 iLowerIndex);
     void operator() (Args... iArgs)
     {
       fire(iArgs...);
     }
-    void operator+= (function<RetTp(Args...)> iFn)
+    template<typename Fn>
+    Token operator+= (Fn && iFn)
     {
-      add(iFn);
+      return add(std::forward<Fn>(iFn));
+    }
+    bool operator-= (Token iToken)
+    {
+      return Remove(iToken);
     }
 };
 
 #endif /* EVENT_H */
-
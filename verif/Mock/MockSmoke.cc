@@ -0,0 +1,117 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   MockSmoke.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Boots the verif library on the VPI mock: $tb_build
+#                     starts a test that writes and reads signals and waits
+#                     on clock edges, checked against the mock's rtl side.
+#                     Exits with the number of failed checks.
+#
+#                     Build and run from verif/ with 'make mocktest'.
+#
+###############################################################################
+*/
+
+#include <iostream>
+#include <string>
+
+#include "Common.h"
+#include "Logic.h"
+#include "pli.h"
+#include "TestBase.h"
+#include "Thread.h"
+#include "vpi_mock.h"
+
+using namespace std;
+
+extern void (*vlog_startup_routines[])();
+
+static UInt32 s_failed = 0;
+
+static void check(bool iOk, const string & iWhat)
+{
+  cout << (iOk ? "PASS " : "FAIL ") << iWhat << endl;
+  if(!iOk)
+  {
+    s_failed++;
+  }
+}
+
+class SmokeTest : public TestBase
+{
+  // Private Members
+  private:
+    vpiHandle m_data;
+    vpiHandle m_cnt;
+    bool      m_ran;
+
+  // Public Properties
+  public:
+    bool  Ran_get() const { return m_ran; }
+
+  // Constructors
+  public:
+    SmokeTest(vpiHandle iData, vpiHandle iCnt)
+      : TestBase("smoke"), m_data(iData), m_cnt(iCnt), m_ran(false)
+    {
+    }
+
+  // Public Methods
+  public:
+    void Run()
+    {
+      m_ran = true;
+      Logic l_data("top.data");
+      Logic l_clk("top.clk");
+      Logic l_cnt("top.cnt");
+
+      // Write from the library, read on the rtl side.
+      l_data = 0x1234;
+      Thread::WaitTime(1);
+      check(VpiMock::Peek(m_data) == 0x1234, "signal write reaches the rtl");
+
+      // Write on the rtl side, read from the library.
+      VpiMock::Drive(m_data, 0xbeef);
+      check((UInt32)l_data == 0xbeef, "rtl write reaches the signal");
+
+      // Two clock edges. The edge wakes the test before the rtl's own
+      // posedge logic has run, read the counter once the step settled.
+      UInt64 l_start = VpiMock::Peek(m_cnt);
+      Thread::WaitCycles(l_clk, 2);
+      Thread::WaitTime(1);
+      check(VpiMock::Peek(m_cnt) == ((l_start + 2) & 0xff), "two posedges counted by the rtl");
+      check((UInt32)l_cnt == VpiMock::Peek(m_cnt), "the counter reads back after the edges");
+    }
+};
+
+int main()
+{
+  VpiMock::AddModule("top", "top");
+  vpiHandle l_clk = VpiMock::AddSignal("top.clk", 1);
+  vpiHandle l_cnt = VpiMock::AddSignal("top.cnt", 8);
+  vpiHandle l_data = VpiMock::AddSignal("top.data", 16);
+  vpiHandle l_build = VpiMock::AddTaskCall("$tb_build", {"top"});
+  VpiMock::AddClock(l_clk, 5);
+  VpiMock::Drive(l_cnt, 0);
+  VpiMock::Always(l_clk, vpiPosedge, [=]() { VpiMock::Drive(l_cnt, (VpiMock::Peek(l_cnt) + 1) & 0xff); });
+  VpiMock::SetArgs({"+c_args=logFile=mock_smoke.log test=smoke"});
+
+  SmokeTest l_test(l_data, l_cnt);
+  VpiMock::Boot(vlog_startup_routines);
+  VpiMock::At(1, [=]() { VpiMock::Call(l_build); });
+  VpiMock::At(1000, []() { Pli::DollarFinish(); });
+  VpiMock::Run(2000);
+  VpiMock::Finish();
+
+  check(l_test.Ran_get(), "$tb_build started the test");
+  check(VpiMock::Finished_get() && (VpiMock::Time_get() < 1000), "the test ended the simulation");
+  cout << ((s_failed == 0) ? "Mock smoke test passed." : "Mock smoke test FAILED.") << endl;
+  return (Int32)s_failed;
+}
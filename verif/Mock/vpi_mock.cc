@@ -0,0 +1,1393 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   vpi_mock.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+#include "vpi_mock.h"
+
+// One object for every kind of handle, 'type' tells which fields are used.
+struct __vpiHandle
+{
+  PLI_INT32                               type;
+  string                                  name;
+  string                                  fullName;
+  string                                  defName;
+  PLI_INT32                               size;       // Bits, or words of an array.
+  PLI_INT32                               direction;
+  PLI_INT32                               index;      // Array words.
+  vpiHandle                               parent;
+  vector<vpiHandle>                       children;   // Scope contents, array words, call arguments, iterator items.
+  vector<vpiHandle>                       ports;
+  vector<PLI_UINT32>                      aval;
+  vector<PLI_UINT32>                      bval;
+  vector<s_vpi_vecval>                    vecBuf;     // vpi_get_value results.
+  string                                  strBuf;
+  // Arrays.
+  PLI_INT32                               width;
+  PLI_INT32                               low;
+  vpiHandle                               left;
+  vpiHandle                               right;
+  vector<vpiHandle>                       cbs;        // cbValueChange on this object.
+  vector<pair<PLI_INT32, function<void()> > > watches;  // Always().
+  UInt32                                  pending;    // Delayed puts in the active queue.
+  void *                                  userData;
+  // Callbacks.
+  s_cb_data                               cbData;
+  s_vpi_time                              cbTime;
+  s_vpi_value                             cbValue;
+  bool                                    removed;
+  // Iterators.
+  UInt32                                  pos;
+  // Systfs and call sites.
+  s_vpi_systf_data                        systf;
+  string                                  tfname;
+  vpiHandle                               def;
+};
+
+namespace
+{
+  enum class ACTION
+  {
+    PUT,
+    CALLBACK,
+    CLOCK,
+    USER
+  };
+  struct Action
+  {
+    ACTION            kind;
+    vpiHandle         obj;
+    vector<PLI_UINT32> aval;
+    vector<PLI_UINT32> bval;
+    UInt64            period;
+    function<void()>  fn;
+  };
+  struct McdFile
+  {
+    FILE *  fp;
+    string  name;
+  };
+}
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+static UInt64                           s_now = 0;
+static UInt64                           s_lastStep = 0;
+static bool                             s_stepped = false;
+static bool                             s_finished = false;
+static bool                             s_ended = false;
+static UInt64                           s_callbacks = 0;
+static vpiHandle                        s_currentCall = NULL;
+static vector<vpiHandle>                s_tops;
+static vector<vpiHandle>                s_calls;
+static vector<vpiHandle>                s_systfs;
+static unordered_map<string, vpiHandle> s_names;
+// Time ordered; equal times keep their insertion order.
+static multimap<UInt64, Action>         s_active;
+static multimap<UInt64, vpiHandle>      s_rwSynch;
+static multimap<UInt64, vpiHandle>      s_roSynch;
+static vector<vpiHandle>                s_nextSimTime;
+static vector<vpiHandle>                s_endOfCompile;
+static vector<vpiHandle>                s_startOfSim;
+static vector<vpiHandle>                s_endOfSim;
+// Fired or removed callbacks, freed at the end of the time step.
+static vector<vpiHandle>                s_retired;
+static vector<string>                   s_args(1, "vpi_mock");
+static vector<char *>                   s_argv;
+static map<PLI_UINT32, McdFile>         s_mcds;
+static map<PLI_INT32, FILE *>           s_fds;
+static const PLI_INT32                  c_timePrecision = -9;
+
+// ===============================
+// ===**  Private Functions  **===
+// ===============================
+static UInt32 nbWords(PLI_INT32 iSize)
+{
+  return (iSize + 31) / 32;
+}
+static bool isArray(vpiHandle iObj)
+{
+  return (iObj != NULL) &&
+         ((iObj->type == vpiRegArray) || (iObj->type == vpiNetArray) || (iObj->type == vpiMemory));
+}
+static bool hasValue(vpiHandle iObj)
+{
+  return (iObj != NULL) && (iObj->aval.size() > 0);
+}
+static vpiHandle newHandle(PLI_INT32 iType, const string & iFullName, vpiHandle iParent)
+{
+  vpiHandle l_hndl = new __vpiHandle();
+  l_hndl->type = iType;
+  l_hndl->fullName = iFullName;
+  size_t l_dot = iFullName.find_last_of('.');
+  l_hndl->name = (l_dot == string::npos) ? iFullName : iFullName.substr(l_dot + 1);
+  l_hndl->direction = vpiNoDirection;
+  l_hndl->parent = iParent;
+  return l_hndl;
+}
+static void initValue(vpiHandle iObj, PLI_INT32 iSize, bool iIsNet)
+{
+  // Variables start at X and nets at Z, as in the simulator.
+  iObj->size = iSize;
+  iObj->aval.assign(nbWords(iSize), iIsNet ? 0 : 0xFFFFFFFF);
+  iObj->bval.assign(nbWords(iSize), 0xFFFFFFFF);
+  if(iSize % 32 != 0)
+  {
+    PLI_UINT32 l_mask = (1u << (iSize % 32)) - 1;
+    iObj->aval.back() &= l_mask;
+    iObj->bval.back() &= l_mask;
+  }
+}
+static vpiHandle parentOf(const string & iPath)
+{
+  size_t l_dot = iPath.find_last_of('.');
+  if(l_dot == string::npos)
+  {
+    return NULL;
+  }
+  unordered_map<string, vpiHandle>::iterator l_it = s_names.find(iPath.substr(0, l_dot));
+  return (l_it == s_names.end()) ? NULL : l_it->second;
+}
+static vpiHandle arrayWord(vpiHandle iArray, PLI_INT32 iIndex)
+{
+  Int32 l_offset = iIndex - iArray->low;
+  if((l_offset < 0) || (l_offset >= iArray->size))
+  {
+    return NULL;
+  }
+  vpiHandle & l_word = iArray->children[l_offset];
+  if(l_word == NULL)
+  {
+    l_word = newHandle(vpiMemoryWord, iArray->fullName + "[" + to_string(iIndex) + "]", iArray);
+    l_word->name = iArray->name + "[" + to_string(iIndex) + "]";
+    l_word->index = iIndex;
+    initValue(l_word, iArray->width, iArray->type == vpiNetArray);
+  }
+  return l_word;
+}
+static vpiHandle lookup(const string & iPath)
+{
+  unordered_map<string, vpiHandle>::iterator l_it = s_names.find(iPath);
+  if(l_it != s_names.end())
+  {
+    return l_it->second;
+  }
+  // mem[3]
+  size_t l_open = iPath.find_last_of('[');
+  if((l_open == string::npos) || (iPath[iPath.size() - 1] != ']'))
+  {
+    return NULL;
+  }
+  l_it = s_names.find(iPath.substr(0, l_open));
+  if((l_it == s_names.end()) || !isArray(l_it->second))
+  {
+    return NULL;
+  }
+  return arrayWord(l_it->second, atoi(iPath.substr(l_open + 1).c_str()));
+}
+static void retire(vpiHandle iCb)
+{
+  s_retired.push_back(iCb);
+}
+static void freeRetired()
+{
+  for(UInt32 ii=0; ii<s_retired.size(); ii++)
+  {
+    delete s_retired[ii];
+  }
+  s_retired.clear();
+}
+static void fillTime(s_vpi_time & oTime)
+{
+  oTime.high = (PLI_UINT32)(s_now >> 32);
+  oTime.low = (PLI_UINT32)s_now;
+  oTime.real = (double)s_now;
+}
+static UInt64 delayOf(p_vpi_time iTime)
+{
+  if(iTime == NULL)
+  {
+    return 0;
+  }
+  if(iTime->type == vpiScaledRealTime)
+  {
+    return (iTime->real > 0) ? (UInt64)iTime->real : 0;
+  }
+  return ((UInt64)iTime->high << 32) | iTime->low;
+}
+// vpi0, vpi1, vpiZ or vpiX of bit 0.
+static PLI_INT32 lsb(vpiHandle iObj)
+{
+  if(!hasValue(iObj))
+  {
+    return vpiX;
+  }
+  PLI_UINT32 l_a = iObj->aval[0] & 1;
+  PLI_UINT32 l_b = iObj->bval[0] & 1;
+  return (l_b == 0) ? (l_a ? vpi1 : vpi0) : (l_a ? vpiX : vpiZ);
+}
+static void setBit(vector<PLI_UINT32> & oAval, vector<PLI_UINT32> & oBval, UInt32 iPos, char iChar)
+{
+  if(iPos / 32 >= oAval.size())
+  {
+    return;
+  }
+  PLI_UINT32 l_bit = 1u << (iPos % 32);
+  bool l_a = (iChar == '1') || (iChar == 'x') || (iChar == 'X');
+  bool l_b = (iChar == 'x') || (iChar == 'X') || (iChar == 'z') || (iChar == 'Z');
+  oAval[iPos / 32] = l_a ? (oAval[iPos / 32] | l_bit) : (oAval[iPos / 32] & ~l_bit);
+  oBval[iPos / 32] = l_b ? (oBval[iPos / 32] | l_bit) : (oBval[iPos / 32] & ~l_bit);
+}
+static bool decodeValue(vpiHandle iObj, p_vpi_value iValue, vector<PLI_UINT32> & oAval, vector<PLI_UINT32> & oBval)
+{
+  UInt32 l_words = nbWords(iObj->size);
+  oAval.assign(l_words, 0);
+  oBval.assign(l_words, 0);
+  switch(iValue->format)
+  {
+    case vpiVectorVal:
+      for(UInt32 kk=0; kk<l_words; kk++)
+      {
+        oAval[kk] = iValue->value.vector[kk].aval;
+        oBval[kk] = iValue->value.vector[kk].bval;
+      }
+      break;
+    case vpiScalarVal:
+      oAval[0] = ((iValue->value.scalar == vpi1) || (iValue->value.scalar == vpiX)) ? 1 : 0;
+      oBval[0] = ((iValue->value.scalar == vpi0) || (iValue->value.scalar == vpi1)) ? 0 : 1;
+      break;
+    case vpiIntVal:
+      oAval[0] = (PLI_UINT32)iValue->value.integer;
+      break;
+    case vpiBinStrVal:
+    case vpiHexStrVal:
+    {
+      string l_str = (iValue->value.str != NULL) ? iValue->value.str : "";
+      UInt32 l_bits = (iValue->format == vpiBinStrVal) ? 1 : 4;
+      for(UInt32 ii=0; ii<l_str.size(); ii++)
+      {
+        char l_c = l_str[l_str.size() - 1 - ii];
+        for(UInt32 kk=0; kk<l_bits; kk++)
+        {
+          char l_bit = l_c;
+          if(l_bits == 4 && isxdigit((unsigned char)l_c))
+          {
+            UInt32 l_nibble = strtoul(string(1, l_c).c_str(), NULL, 16);
+            l_bit = ((l_nibble >> kk) & 1) ? '1' : '0';
+          }
+          setBit(oAval, oBval, ii * l_bits + kk, l_bit);
+        }
+      }
+      break;
+    }
+    default:
+      cout << "vpi_mock: value format " << iValue->format << " can't be put on '" << iObj->fullName << "'." << endl;
+      return false;
+  }
+  if(iObj->size % 32 != 0)
+  {
+    PLI_UINT32 l_mask = (1u << (iObj->size % 32)) - 1;
+    oAval.back() &= l_mask;
+    oBval.back() &= l_mask;
+  }
+  return true;
+}
+static void fireCB(vpiHandle iCb, vpiHandle iObj)
+{
+  s_vpi_time l_time;
+  s_vpi_value l_value;
+  s_cb_data l_data = iCb->cbData;
+  if(iObj != NULL)
+  {
+    l_data.obj = iObj;
+  }
+  if(iCb->cbData.time != NULL)
+  {
+    l_time.type = iCb->cbTime.type;
+    fillTime(l_time);
+    l_data.time = &l_time;
+  }
+  if((iCb->cbData.value != NULL) && (iObj != NULL))
+  {
+    l_value.format = iCb->cbValue.format;
+    if(l_value.format != vpiSuppressVal)
+    {
+      vpi_get_value(iObj, &l_value);
+    }
+    l_data.value = &l_value;
+  }
+  l_data.index = ((iObj != NULL) && (iObj->type == vpiMemoryWord)) ? iObj->index : 0;
+  s_callbacks++;
+  l_data.cb_rtn(&l_data);
+}
+static void setValue(vpiHandle iObj, const vector<PLI_UINT32> & iAval, const vector<PLI_UINT32> & iBval)
+{
+  if((iObj->aval == iAval) && (iObj->bval == iBval))
+  {
+    return;
+  }
+  PLI_INT32 l_old = lsb(iObj);
+  iObj->aval = iAval;
+  iObj->bval = iBval;
+  PLI_INT32 l_new = lsb(iObj);
+
+  // A callback may add or remove callbacks, walk a copy.
+  vector<vpiHandle> l_cbs = iObj->cbs;
+  if((iObj->type == vpiMemoryWord) && (iObj->parent != NULL))
+  {
+    l_cbs.insert(l_cbs.end(), iObj->parent->cbs.begin(), iObj->parent->cbs.end());
+  }
+  for(UInt32 ii=0; ii<l_cbs.size(); ii++)
+  {
+    if(!l_cbs[ii]->removed)
+    {
+      fireCB(l_cbs[ii], iObj);
+    }
+  }
+
+  bool l_posedge = ((l_old == vpi0) && (l_new != vpi0)) || ((l_old != vpi1) && (l_new == vpi1));
+  bool l_negedge = ((l_old == vpi1) && (l_new != vpi1)) || ((l_old != vpi0) && (l_new == vpi0));
+  for(UInt32 ii=0; ii<iObj->watches.size(); ii++)
+  {
+    PLI_INT32 l_edge = iObj->watches[ii].first;
+    if(((l_edge == vpiPosedge) && !l_posedge) || ((l_edge == vpiNegedge) && !l_negedge))
+    {
+      continue;
+    }
+    iObj->watches[ii].second();
+  }
+}
+static vpiHandle findSystf(const string & iName)
+{
+  for(UInt32 ii=0; ii<s_systfs.size(); ii++)
+  {
+    if(s_systfs[ii]->tfname == iName)
+    {
+      return s_systfs[ii];
+    }
+  }
+  return NULL;
+}
+static void firePhase(vector<vpiHandle> & ioCbs)
+{
+  vector<vpiHandle> l_cbs;
+  l_cbs.swap(ioCbs);
+  for(UInt32 ii=0; ii<l_cbs.size(); ii++)
+  {
+    if(!l_cbs[ii]->removed)
+    {
+      fireCB(l_cbs[ii], NULL);
+    }
+    retire(l_cbs[ii]);
+  }
+}
+static void fireSynch(multimap<UInt64, vpiHandle> & ioQueue, UInt64 iTime, bool & oFired)
+{
+  vector<vpiHandle> l_cbs;
+  while((ioQueue.size() > 0) && (ioQueue.begin()->first == iTime))
+  {
+    l_cbs.push_back(ioQueue.begin()->second);
+    ioQueue.erase(ioQueue.begin());
+  }
+  oFired = (l_cbs.size() > 0);
+  for(UInt32 ii=0; ii<l_cbs.size(); ii++)
+  {
+    if(!l_cbs[ii]->removed && !s_finished)
+    {
+      fireCB(l_cbs[ii], NULL);
+    }
+    retire(l_cbs[ii]);
+  }
+}
+static void schedule(UInt64 iTime, const Action & iAction)
+{
+  s_active.insert(make_pair(iTime, iAction));
+}
+static void runActive(UInt64 iTime)
+{
+  while(!s_finished && (s_active.size() > 0) && (s_active.begin()->first == iTime))
+  {
+    Action l_act = s_active.begin()->second;
+    s_active.erase(s_active.begin());
+    switch(l_act.kind)
+    {
+      case ACTION::PUT:
+        l_act.obj->pending--;
+        setValue(l_act.obj, l_act.aval, l_act.bval);
+        break;
+      case ACTION::CALLBACK:
+        if(!l_act.obj->removed)
+        {
+          fireCB(l_act.obj, NULL);
+        }
+        retire(l_act.obj);
+        break;
+      case ACTION::CLOCK:
+      {
+        vector<PLI_UINT32> l_aval(1, (lsb(l_act.obj) == vpi1) ? 0 : 1);
+        vector<PLI_UINT32> l_bval(1, 0);
+        setValue(l_act.obj, l_aval, l_bval);
+        schedule(iTime + l_act.period, l_act);
+        break;
+      }
+      case ACTION::USER:
+        l_act.fn();
+        break;
+    }
+  }
+}
+static void step(UInt64 iTime)
+{
+  if(!s_stepped || (iTime != s_lastStep))
+  {
+    s_stepped = true;
+    s_lastStep = iTime;
+    firePhase(s_nextSimTime);
+  }
+  bool l_fired = true;
+  while(l_fired && !s_finished)
+  {
+    runActive(iTime);
+    // Zero delay puts from ReadWriteSynch go back through the active region.
+    fireSynch(s_rwSynch, iTime, l_fired);
+  }
+  fireSynch(s_roSynch, iTime, l_fired);
+  freeRetired();
+}
+static bool nextTime(UInt64 & oTime)
+{
+  bool l_retVal = false;
+  if(s_active.size() > 0)
+  {
+    oTime = s_active.begin()->first;
+    l_retVal = true;
+  }
+  if((s_rwSynch.size() > 0) && (!l_retVal || (s_rwSynch.begin()->first < oTime)))
+  {
+    oTime = s_rwSynch.begin()->first;
+    l_retVal = true;
+  }
+  if((s_roSynch.size() > 0) && (!l_retVal || (s_roSynch.begin()->first < oTime)))
+  {
+    oTime = s_roSynch.begin()->first;
+    l_retVal = true;
+  }
+  return l_retVal;
+}
+static void control(PLI_INT32 iOperation)
+{
+  // There is no interactive mode, $stop ends the run too.
+  if((iOperation == vpiFinish) || (iOperation == vpiStop))
+  {
+    s_finished = true;
+  }
+}
+
+// ===============================
+// ===**  Public Properties  **===
+// ===============================
+UInt64 VpiMock::Time_get()
+{
+  return s_now;
+}
+bool VpiMock::Finished_get()
+{
+  return s_finished;
+}
+UInt64 VpiMock::Callbacks_get()
+{
+  return s_callbacks;
+}
+
+// ============================
+// ===**  Public Methods  **===
+// ============================
+vpiHandle VpiMock::AddModule(const string & iPath, const string & iDefName)
+{
+  if(s_names.find(iPath) != s_names.end())
+  {
+    cout << "vpi_mock: '" << iPath << "' was already added." << endl;
+    return s_names[iPath];
+  }
+  vpiHandle l_parent = parentOf(iPath);
+  if((l_parent == NULL) && (iPath.find('.') != string::npos))
+  {
+    cout << "vpi_mock: the parent of module '" << iPath << "' was not added." << endl;
+    return NULL;
+  }
+  vpiHandle l_mod = newHandle(vpiModule, iPath, l_parent);
+  l_mod->defName = (iDefName.size() > 0) ? iDefName : l_mod->name;
+  if(l_parent != NULL)
+  {
+    l_parent->children.push_back(l_mod);
+  }
+  else
+  {
+    s_tops.push_back(l_mod);
+  }
+  s_names[iPath] = l_mod;
+  return l_mod;
+}
+vpiHandle VpiMock::AddSignal(const string & iPath, UInt32 iSize, Int32 iType, Int32 iDirection)
+{
+  vpiHandle l_parent = parentOf(iPath);
+  if((l_parent == NULL) || (l_parent->type != vpiModule))
+  {
+    cout << "vpi_mock: the module of '" << iPath << "' was not added." << endl;
+    return NULL;
+  }
+  if((iType != vpiNet) && (iType != vpiReg) && (iType != vpiIntegerVar))
+  {
+    cout << "vpi_mock: '" << iPath << "' must be a vpiNet, vpiReg or vpiIntegerVar." << endl;
+    return NULL;
+  }
+  if(s_names.find(iPath) != s_names.end())
+  {
+    cout << "vpi_mock: '" << iPath << "' was already added." << endl;
+    return s_names[iPath];
+  }
+  vpiHandle l_sig = newHandle(iType, iPath, l_parent);
+  initValue(l_sig, (iType == vpiIntegerVar) ? 32 : iSize, iType == vpiNet);
+  l_sig->direction = iDirection;
+  l_parent->children.push_back(l_sig);
+  if(iDirection != vpiNoDirection)
+  {
+    vpiHandle l_port = newHandle(vpiPort, iPath, l_parent);
+    l_port->direction = iDirection;
+    l_port->size = l_sig->size;
+    l_parent->ports.push_back(l_port);
+  }
+  s_names[iPath] = l_sig;
+  return l_sig;
+}
+vpiHandle VpiMock::AddArray(const string & iPath, UInt32 iWidth, UInt32 iDepth, Int32 iLeft, Int32 iType)
+{
+  vpiHandle l_parent = parentOf(iPath);
+  if((l_parent == NULL) || (l_parent->type != vpiModule))
+  {
+    cout << "vpi_mock: the module of '" << iPath << "' was not added." << endl;
+    return NULL;
+  }
+  if(s_names.find(iPath) != s_names.end())
+  {
+    cout << "vpi_mock: '" << iPath << "' was already added." << endl;
+    return s_names[iPath];
+  }
+  vpiHandle l_arr = newHandle(iType, iPath, l_parent);
+  l_arr->size = iDepth;
+  l_arr->width = iWidth;
+  l_arr->low = iLeft;
+  l_arr->children.assign(iDepth, NULL);
+  l_arr->left = newHandle(vpiConstant, "", l_arr);
+  l_arr->right = newHandle(vpiConstant, "", l_arr);
+  initValue(l_arr->left, 32, false);
+  initValue(l_arr->right, 32, false);
+  l_arr->left->aval[0] = iLeft;
+  l_arr->left->bval[0] = 0;
+  l_arr->right->aval[0] = iLeft + iDepth - 1;
+  l_arr->right->bval[0] = 0;
+  l_parent->children.push_back(l_arr);
+  s_names[iPath] = l_arr;
+  return l_arr;
+}
+vpiHandle VpiMock::AddTaskCall(const string & iName, const vector<string> & iArgs, const string & iScope)
+{
+  vpiHandle l_scope = (iScope.size() > 0) ? lookup(iScope) : NULL;
+  vpiHandle l_call = newHandle(vpiSysTaskCall, iName, l_scope);
+  for(UInt32 ii=0; ii<iArgs.size(); ii++)
+  {
+    vpiHandle l_arg = vpi_handle_by_name(iArgs[ii].c_str(), l_scope);
+    if(l_arg == NULL)
+    {
+      cout << "vpi_mock: argument '" << iArgs[ii] << "' of " << iName << " was not added." << endl;
+      delete l_call;
+      return NULL;
+    }
+    l_call->children.push_back(l_arg);
+  }
+  s_calls.push_back(l_call);
+  return l_call;
+}
+void VpiMock::SetArgs(const vector<string> & iArgs)
+{
+  s_args.assign(1, "vpi_mock");
+  s_args.insert(s_args.end(), iArgs.begin(), iArgs.end());
+}
+void VpiMock::Boot(void (**iRoutines)())
+{
+  for(UInt32 ii=0; (iRoutines != NULL) && (iRoutines[ii] != NULL); ii++)
+  {
+    iRoutines[ii]();
+  }
+  for(UInt32 ii=0; ii<s_calls.size(); ii++)
+  {
+    vpiHandle l_call = s_calls[ii];
+    l_call->def = findSystf(l_call->name);
+    if(l_call->def == NULL)
+    {
+      cout << "vpi_mock: " << l_call->name << " was not registered." << endl;
+      continue;
+    }
+    if(l_call->def->systf.compiletf != NULL)
+    {
+      s_currentCall = l_call;
+      l_call->def->systf.compiletf(l_call->def->systf.user_data);
+      s_currentCall = NULL;
+    }
+  }
+  firePhase(s_endOfCompile);
+  firePhase(s_startOfSim);
+  freeRetired();
+}
+void VpiMock::Call(vpiHandle iCall)
+{
+  if((iCall == NULL) || (iCall->type != vpiSysTaskCall))
+  {
+    return;
+  }
+  if(iCall->def == NULL)
+  {
+    iCall->def = findSystf(iCall->name);
+  }
+  if((iCall->def == NULL) || (iCall->def->systf.calltf == NULL))
+  {
+    cout << "vpi_mock: " << iCall->name << " was not registered." << endl;
+    return;
+  }
+  vpiHandle l_prev = s_currentCall;
+  s_currentCall = iCall;
+  iCall->def->systf.calltf(iCall->def->systf.user_data);
+  s_currentCall = l_prev;
+}
+void VpiMock::Drive(vpiHandle iObj, UInt64 iValue)
+{
+  if(!hasValue(iObj))
+  {
+    return;
+  }
+  vector<UInt32> l_aval(iObj->aval.size(), 0);
+  vector<UInt32> l_bval(iObj->bval.size(), 0);
+  l_aval[0] = (UInt32)iValue;
+  if(l_aval.size() > 1)
+  {
+    l_aval[1] = (UInt32)(iValue >> 32);
+  }
+  Drive(iObj, l_aval, l_bval);
+}
+void VpiMock::Drive(vpiHandle iObj, const vector<UInt32> & iAval, const vector<UInt32> & iBval)
+{
+  if(!hasValue(iObj))
+  {
+    return;
+  }
+  s_vpi_value l_value;
+  vector<s_vpi_vecval> l_vec(iObj->aval.size());
+  for(UInt32 kk=0; kk<l_vec.size(); kk++)
+  {
+    l_vec[kk].aval = (kk < iAval.size()) ? iAval[kk] : 0;
+    l_vec[kk].bval = (kk < iBval.size()) ? iBval[kk] : 0;
+  }
+  l_value.format = vpiVectorVal;
+  l_value.value.vector = &l_vec[0];
+  vector<PLI_UINT32> l_aval;
+  vector<PLI_UINT32> l_bval;
+  decodeValue(iObj, &l_value, l_aval, l_bval);
+  setValue(iObj, l_aval, l_bval);
+}
+UInt64 VpiMock::Peek(vpiHandle iObj)
+{
+  if(!hasValue(iObj))
+  {
+    return 0;
+  }
+  UInt64 l_retVal = iObj->aval[0];
+  if(iObj->aval.size() > 1)
+  {
+    l_retVal |= (UInt64)iObj->aval[1] << 32;
+  }
+  return l_retVal;
+}
+void VpiMock::AddClock(vpiHandle iClk, UInt64 iHalfPeriod, UInt64 iStart)
+{
+  if(!hasValue(iClk) || (iHalfPeriod == 0))
+  {
+    cout << "vpi_mock: a clock needs a signal and a non zero half period." << endl;
+    return;
+  }
+  Drive(iClk, 0);
+  Action l_act;
+  l_act.kind = ACTION::CLOCK;
+  l_act.obj = iClk;
+  l_act.period = iHalfPeriod;
+  schedule(s_now + iStart + iHalfPeriod, l_act);
+}
+void VpiMock::At(UInt64 iTime, function<void()> iFn)
+{
+  if(iTime < s_now)
+  {
+    cout << "vpi_mock: At(" << iTime << ") is in the past (now " << s_now << ")." << endl;
+    return;
+  }
+  Action l_act;
+  l_act.kind = ACTION::USER;
+  l_act.obj = NULL;
+  l_act.period = 0;
+  l_act.fn = iFn;
+  schedule(iTime, l_act);
+}
+void VpiMock::Always(vpiHandle iSig, Int32 iEdge, function<void()> iFn)
+{
+  if(!hasValue(iSig))
+  {
+    return;
+  }
+  iSig->watches.push_back(make_pair(iEdge, iFn));
+}
+bool VpiMock::Run(UInt64 iTicks)
+{
+  UInt64 l_end = s_now + iTicks;
+  UInt64 l_next;
+  while(!s_finished && nextTime(l_next) && (l_next <= l_end))
+  {
+    s_now = l_next;
+    step(s_now);
+  }
+  if(!s_finished)
+  {
+    s_now = l_end;
+  }
+  return !s_finished;
+}
+void VpiMock::Finish()
+{
+  if(s_ended)
+  {
+    return;
+  }
+  s_ended = true;
+  firePhase(s_endOfSim);
+  freeRetired();
+}
+
+// ===================================
+// ===**  vpi_user.h Functions   **===
+// ===================================
+extern "C"
+{
+
+vpiHandle vpi_register_systf(const struct t_vpi_systf_data * ss)
+{
+  if((ss == NULL) || (ss->tfname == NULL))
+  {
+    return NULL;
+  }
+  vpiHandle l_tf = newHandle(vpiUserSystf, ss->tfname, NULL);
+  l_tf->tfname = ss->tfname;
+  l_tf->systf = *ss;
+  l_tf->systf.tfname = l_tf->tfname.c_str();
+  s_systfs.push_back(l_tf);
+  return l_tf;
+}
+void vpi_get_systf_info(vpiHandle obj, p_vpi_systf_data data)
+{
+  if((obj != NULL) && (obj->type == vpiSysTaskCall))
+  {
+    obj = obj->def;
+  }
+  if((obj != NULL) && (data != NULL))
+  {
+    *data = obj->systf;
+  }
+}
+PLI_UINT32 vpi_mcd_open(char * name)
+{
+  if(name == NULL)
+  {
+    return 0;
+  }
+  for(UInt32 ii=1; ii<31; ii++)
+  {
+    if(s_mcds.find(1u << ii) == s_mcds.end())
+    {
+      FILE * l_fp = fopen(name, "w");
+      if(l_fp == NULL)
+      {
+        return 0;
+      }
+      s_mcds[1u << ii].fp = l_fp;
+      s_mcds[1u << ii].name = name;
+      return 1u << ii;
+    }
+  }
+  return 0;
+}
+PLI_UINT32 vpi_mcd_close(PLI_UINT32 mcd)
+{
+  PLI_UINT32 l_retVal = 0;
+  for(UInt32 ii=1; ii<31; ii++)
+  {
+    if(((mcd >> ii) & 1) == 0)
+    {
+      continue;
+    }
+    map<PLI_UINT32, McdFile>::iterator l_it = s_mcds.find(1u << ii);
+    if(l_it == s_mcds.end())
+    {
+      l_retVal |= 1u << ii;
+      continue;
+    }
+    fclose(l_it->second.fp);
+    s_mcds.erase(l_it);
+  }
+  return l_retVal;
+}
+char * vpi_mcd_name(PLI_UINT32 mcd)
+{
+  if(mcd == 1)
+  {
+    return (char *)"stdout";
+  }
+  map<PLI_UINT32, McdFile>::iterator l_it = s_mcds.find(mcd);
+  return (l_it == s_mcds.end()) ? NULL : (char *)l_it->second.name.c_str();
+}
+PLI_INT32 vpi_mcd_vprintf(PLI_UINT32 mcd, const char * fmt, va_list ap)
+{
+  PLI_INT32 l_retVal = 0;
+  for(UInt32 ii=0; ii<31; ii++)
+  {
+    if(((mcd >> ii) & 1) == 0)
+    {
+      continue;
+    }
+    FILE * l_fp = stdout;
+    if(ii > 0)
+    {
+      map<PLI_UINT32, McdFile>::iterator l_it = s_mcds.find(1u << ii);
+      if(l_it == s_mcds.end())
+      {
+        continue;
+      }
+      l_fp = l_it->second.fp;
+    }
+    va_list l_ap;
+    va_copy(l_ap, ap);
+    l_retVal = vfprintf(l_fp, fmt, l_ap);
+    va_end(l_ap);
+  }
+  return l_retVal;
+}
+PLI_INT32 vpi_mcd_printf(PLI_UINT32 mcd, const char * fmt, ...)
+{
+  va_list l_ap;
+  va_start(l_ap, fmt);
+  PLI_INT32 l_retVal = vpi_mcd_vprintf(mcd, fmt, l_ap);
+  va_end(l_ap);
+  return l_retVal;
+}
+PLI_INT32 vpi_vprintf(const char * fmt, va_list ap)
+{
+  return vprintf(fmt, ap);
+}
+PLI_INT32 vpi_printf(const char * fmt, ...)
+{
+  va_list l_ap;
+  va_start(l_ap, fmt);
+  PLI_INT32 l_retVal = vprintf(fmt, l_ap);
+  va_end(l_ap);
+  return l_retVal;
+}
+PLI_INT32 vpi_flush(void)
+{
+  return fflush(stdout);
+}
+PLI_INT32 vpi_mcd_flush(PLI_UINT32 mcd)
+{
+  if(mcd & 1)
+  {
+    fflush(stdout);
+  }
+  for(map<PLI_UINT32, McdFile>::iterator l_it = s_mcds.begin(); l_it != s_mcds.end(); l_it++)
+  {
+    if(mcd & l_it->first)
+    {
+      fflush(l_it->second.fp);
+    }
+  }
+  return 0;
+}
+PLI_INT32 vpi_fopen(const char * name, const char * mode)
+{
+  FILE * l_fp = fopen(name, mode);
+  if(l_fp == NULL)
+  {
+    return 0;
+  }
+  // 0x80000000 to 0x80000002 are stdin, stdout and stderr.
+  PLI_INT32 l_fd = (PLI_INT32)(0x80000003u + s_fds.size());
+  s_fds[l_fd] = l_fp;
+  return l_fd;
+}
+FILE * vpi_get_file(PLI_INT32 fd)
+{
+  switch((PLI_UINT32)fd)
+  {
+    case 0x80000000u:
+      return stdin;
+    case 0x80000001u:
+      return stdout;
+    case 0x80000002u:
+      return stderr;
+    default:
+      break;
+  }
+  map<PLI_INT32, FILE *>::iterator l_it = s_fds.find(fd);
+  return (l_it == s_fds.end()) ? NULL : l_it->second;
+}
+vpiHandle vpi_register_cb(p_cb_data data)
+{
+  if((data == NULL) || (data->cb_rtn == NULL))
+  {
+    return NULL;
+  }
+  if((data->reason == cbValueChange) && !hasValue(data->obj) && !isArray(data->obj))
+  {
+    cout << "vpi_mock: cbValueChange needs a net, reg, integer or array object." << endl;
+    return NULL;
+  }
+  vpiHandle l_cb = newHandle(vpiCallback, "", NULL);
+  l_cb->cbData = *data;
+  if(data->time != NULL)
+  {
+    l_cb->cbTime = *data->time;
+    l_cb->cbData.time = &l_cb->cbTime;
+  }
+  if(data->value != NULL)
+  {
+    l_cb->cbValue = *data->value;
+    l_cb->cbData.value = &l_cb->cbValue;
+  }
+  UInt64 l_time = s_now + delayOf(data->time);
+  switch(data->reason)
+  {
+    case cbValueChange:
+      data->obj->cbs.push_back(l_cb);
+      break;
+    case cbAfterDelay:
+    {
+      Action l_act;
+      l_act.kind = ACTION::CALLBACK;
+      l_act.obj = l_cb;
+      l_act.period = 0;
+      schedule(l_time, l_act);
+      break;
+    }
+    case cbReadWriteSynch:
+      s_rwSynch.insert(make_pair(l_time, l_cb));
+      break;
+    case cbReadOnlySynch:
+      s_roSynch.insert(make_pair(l_time, l_cb));
+      break;
+    case cbNextSimTime:
+      s_nextSimTime.push_back(l_cb);
+      break;
+    case cbEndOfCompile:
+      s_endOfCompile.push_back(l_cb);
+      break;
+    case cbStartOfSimulation:
+      s_startOfSim.push_back(l_cb);
+      break;
+    case cbEndOfSimulation:
+      s_endOfSim.push_back(l_cb);
+      break;
+    default:
+      // Accepted, never fired.
+      break;
+  }
+  return l_cb;
+}
+PLI_INT32 vpi_remove_cb(vpiHandle ref)
+{
+  if((ref == NULL) || (ref->type != vpiCallback) || ref->removed)
+  {
+    return 0;
+  }
+  ref->removed = true;
+  switch(ref->cbData.reason)
+  {
+    case cbValueChange:
+    {
+      vector<vpiHandle> & l_cbs = ref->cbData.obj->cbs;
+      for(UInt32 ii=0; ii<l_cbs.size(); ii++)
+      {
+        if(l_cbs[ii] == ref)
+        {
+          l_cbs.erase(l_cbs.begin() + ii);
+          break;
+        }
+      }
+      retire(ref);
+      break;
+    }
+    case cbAfterDelay:
+    case cbReadWriteSynch:
+    case cbReadOnlySynch:
+    case cbNextSimTime:
+    case cbEndOfCompile:
+    case cbStartOfSimulation:
+    case cbEndOfSimulation:
+      // Still queued, retired when its turn comes.
+      break;
+    default:
+      retire(ref);
+      break;
+  }
+  return 1;
+}
+void vpi_control(PLI_INT32 operation, ...)
+{
+  control(operation);
+}
+void vpi_sim_control(PLI_INT32 operation, ...)
+{
+  control(operation);
+}
+vpiHandle vpi_handle(PLI_INT32 type, vpiHandle ref)
+{
+  switch(type)
+  {
+    case vpiSysTfCall:
+      return s_currentCall;
+    case vpiLeftRange:
+      return isArray(ref) ? ref->left : NULL;
+    case vpiRightRange:
+      return isArray(ref) ? ref->right : NULL;
+    case vpiScope:
+    case vpiModule:
+    case vpiParent:
+      return (ref != NULL) ? ref->parent : NULL;
+    default:
+      return NULL;
+  }
+}
+vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle ref)
+{
+  vector<vpiHandle> l_items;
+  if(ref == NULL)
+  {
+    if(type == vpiModule)
+    {
+      l_items = s_tops;
+    }
+  }
+  else if((type == vpiArgument) && (ref->type == vpiSysTaskCall))
+  {
+    l_items = ref->children;
+  }
+  else if(type == vpiPort)
+  {
+    l_items = ref->ports;
+  }
+  else if(isArray(ref))
+  {
+    if((type == vpiMemoryWord) || (type == vpiReg) || (type == vpiNet))
+    {
+      for(Int32 ii=0; ii<ref->size; ii++)
+      {
+        l_items.push_back(arrayWord(ref, ref->low + ii));
+      }
+    }
+  }
+  else if(ref->type == vpiModule)
+  {
+    PLI_INT32 l_type = (type == vpiInternalScope) ? vpiModule : type;
+    for(UInt32 ii=0; ii<ref->children.size(); ii++)
+    {
+      if(ref->children[ii]->type == l_type)
+      {
+        l_items.push_back(ref->children[ii]);
+      }
+    }
+  }
+  if(l_items.size() == 0)
+  {
+    return NULL;
+  }
+  vpiHandle l_iter = newHandle(vpiIterator, "", ref);
+  l_iter->children.swap(l_items);
+  return l_iter;
+}
+vpiHandle vpi_scan(vpiHandle iter)
+{
+  if((iter == NULL) || (iter->type != vpiIterator))
+  {
+    return NULL;
+  }
+  if(iter->pos < iter->children.size())
+  {
+    return iter->children[iter->pos++];
+  }
+  // The iterator is freed once it is exhausted.
+  delete iter;
+  return NULL;
+}
+vpiHandle vpi_handle_by_index(vpiHandle ref, PLI_INT32 index)
+{
+  return isArray(ref) ? arrayWord(ref, index) : NULL;
+}
+vpiHandle vpi_handle_by_name(const char * name, vpiHandle scope)
+{
+  if(name == NULL)
+  {
+    return NULL;
+  }
+  if(scope != NULL)
+  {
+    vpiHandle l_hndl = lookup(scope->fullName + "." + name);
+    if(l_hndl != NULL)
+    {
+      return l_hndl;
+    }
+  }
+  return lookup(name);
+}
+void vpi_get_time(vpiHandle UNUSED(obj), s_vpi_time * t)
+{
+  if(t != NULL)
+  {
+    fillTime(*t);
+  }
+}
+PLI_INT32 vpi_get(int property, vpiHandle ref)
+{
+  if((property == vpiTimeUnit) || (property == vpiTimePrecision))
+  {
+    return c_timePrecision;
+  }
+  if(ref == NULL)
+  {
+    return vpiUndefined;
+  }
+  switch(property)
+  {
+    case vpiType:
+      return ref->type;
+    case vpiSize:
+      return ref->size;
+    case vpiDirection:
+      return ref->direction;
+    case vpiTopModule:
+      return (ref->type == vpiModule) && (ref->parent == NULL);
+    case vpiArray:
+      return isArray(ref) || (ref->type == vpiMemoryWord);
+    case vpiScalar:
+      return hasValue(ref) && (ref->size == 1);
+    case vpiVector:
+      return hasValue(ref) && (ref->size > 1);
+    case vpiIndex:
+      return ref->index;
+    default:
+      return vpiUndefined;
+  }
+}
+char * vpi_get_str(PLI_INT32 property, vpiHandle ref)
+{
+  if(ref == NULL)
+  {
+    return NULL;
+  }
+  switch(property)
+  {
+    case vpiName:
+      return (char *)ref->name.c_str();
+    case vpiFullName:
+      return (char *)ref->fullName.c_str();
+    case vpiDefName:
+      return (ref->type == vpiModule) ? (char *)ref->defName.c_str() : NULL;
+    default:
+      return NULL;
+  }
+}
+void vpi_get_value(vpiHandle expr, p_vpi_value value)
+{
+  if((value == NULL) || !hasValue(expr))
+  {
+    return;
+  }
+  if(value->format == vpiObjTypeVal)
+  {
+    value->format = (expr->size == 1) ? vpiScalarVal : (expr->type == vpiIntegerVar) ? vpiIntVal : vpiVectorVal;
+  }
+  switch(value->format)
+  {
+    case vpiVectorVal:
+      expr->vecBuf.resize(expr->aval.size());
+      for(UInt32 kk=0; kk<expr->aval.size(); kk++)
+      {
+        expr->vecBuf[kk].aval = expr->aval[kk];
+        expr->vecBuf[kk].bval = expr->bval[kk];
+      }
+      value->value.vector = &expr->vecBuf[0];
+      break;
+    case vpiScalarVal:
+      value->value.scalar = lsb(expr);
+      break;
+    case vpiIntVal:
+      value->value.integer = (PLI_INT32)(expr->aval[0] & ~expr->bval[0]);
+      break;
+    case vpiBinStrVal:
+    case vpiHexStrVal:
+    {
+      UInt32 l_bits = (value->format == vpiBinStrVal) ? 1 : 4;
+      UInt32 l_digits = (expr->size + l_bits - 1) / l_bits;
+      expr->strBuf.assign(l_digits, '0');
+      for(UInt32 ii=0; ii<l_digits; ii++)
+      {
+        UInt32 l_a = 0;
+        UInt32 l_b = 0;
+        for(UInt32 kk=0; (kk<l_bits) && (ii * l_bits + kk < (UInt32)expr->size); kk++)
+        {
+          UInt32 l_pos = ii * l_bits + kk;
+          l_a |= ((expr->aval[l_pos / 32] >> (l_pos % 32)) & 1) << kk;
+          l_b |= ((expr->bval[l_pos / 32] >> (l_pos % 32)) & 1) << kk;
+        }
+        char l_c = "0123456789abcdef"[l_a];
+        if(l_b != 0)
+        {
+          l_c = (l_a == l_b) ? 'x' : (l_a == 0) ? 'z' : 'X';
+        }
+        expr->strBuf[l_digits - 1 - ii] = l_c;
+      }
+      value->value.str = (char *)expr->strBuf.c_str();
+      break;
+    }
+    case vpiSuppressVal:
+      break;
+    default:
+      cout << "vpi_mock: value format " << value->format << " of '" << expr->fullName << "' is not supported." << endl;
+      break;
+  }
+}
+vpiHandle vpi_put_value(vpiHandle obj, p_vpi_value value, p_vpi_time when, PLI_INT32 flags)
+{
+  if((value == NULL) || !hasValue(obj) || (obj->type == vpiConstant))
+  {
+    return NULL;
+  }
+  vector<PLI_UINT32> l_aval;
+  vector<PLI_UINT32> l_bval;
+  if(!decodeValue(obj, value, l_aval, l_bval))
+  {
+    return NULL;
+  }
+  // The upper bits carry vpiReturnEvent.
+  PLI_INT32 l_mode = flags & 0xFF;
+  if((l_mode == vpiNoDelay) || (when == NULL))
+  {
+    setValue(obj, l_aval, l_bval);
+    return NULL;
+  }
+  UInt64 l_time = s_now + delayOf(when);
+  if((obj->pending > 0) && (l_mode != vpiPureTransportDelay))
+  {
+    // Inertial drops every pending put of the object, transport the later ones.
+    multimap<UInt64, Action>::iterator l_it = s_active.begin();
+    while(l_it != s_active.end())
+    {
+      if((l_it->second.kind == ACTION::PUT) && (l_it->second.obj == obj) &&
+         ((l_mode == vpiInertialDelay) || (l_it->first > l_time)))
+      {
+        obj->pending--;
+        l_it = s_active.erase(l_it);
+      }
+      else
+      {
+        l_it++;
+      }
+    }
+  }
+  Action l_act;
+  l_act.kind = ACTION::PUT;
+  l_act.obj = obj;
+  l_act.aval.swap(l_aval);
+  l_act.bval.swap(l_bval);
+  l_act.period = 0;
+  schedule(l_time, l_act);
+  obj->pending++;
+  return NULL;
+}
+PLI_INT32 vpi_free_object(vpiHandle ref)
+{
+  // Everything else is owned by the mock.
+  if((ref != NULL) && (ref->type == vpiIterator))
+  {
+    delete ref;
+  }
+  return 1;
+}
+PLI_INT32 vpi_get_vlog_info(p_vpi_vlog_info vlog_info_p)
+{
+  if(vlog_info_p == NULL)
+  {
+    return 0;
+  }
+  s_argv.clear();
+  for(UInt32 ii=0; ii<s_args.size(); ii++)
+  {
+    s_argv.push_back((char *)s_args[ii].c_str());
+  }
+  vlog_info_p->argc = s_argv.size();
+  vlog_info_p->argv = &s_argv[0];
+  vlog_info_p->product = (char *)"vpi_mock";
+  vlog_info_p->version = (char *)"1.0";
+  return 1;
+}
+PLI_INT32 vpi_compare_objects(vpiHandle obj1, vpiHandle obj2)
+{
+  return obj1 == obj2;
+}
+void vpi_get_delays(vpiHandle UNUSED(expr), p_vpi_delay UNUSED(delays))
+{
+}
+void vpi_put_delays(vpiHandle UNUSED(expr), p_vpi_delay UNUSED(delays))
+{
+}
+PLI_INT32 vpi_put_userdata(vpiHandle obj, void * data)
+{
+  if(obj == NULL)
+  {
+    return 0;
+  }
+  obj->userData = data;
+  return 1;
+}
+void * vpi_get_userdata(vpiHandle obj)
+{
+  return (obj != NULL) ? obj->userData : NULL;
+}
+PLI_INT32 vpi_chk_error(p_vpi_error_info UNUSED(info))
+{
+  return 0;
+}
+
+}
+
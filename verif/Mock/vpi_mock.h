@@ -0,0 +1,97 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   vpi_mock.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   In-memory stand-in for the simulator's VPI, so the verif
+#                     library (BitVector, TypeBase, Logger, TestController,
+#                     agents) runs in a plain executable for unit tests and
+#                     benchmarks.
+#                     vpi_mock.cc defines the vpi_* functions of vpi_user.h;
+#                     it is selected at link time by linking libverif_mock.a
+#                     ('make mock' from verif/) instead of loading the .vpi
+#                     into a simulator. 'make mocktest' runs MockSmoke.cc,
+#                     a test booted on the mock.
+#
+#                     The design is a table of modules, nets, regs and arrays
+#                     built with Add*() before Boot(). Run() advances a
+#                     simulated time loop; every time step runs the active
+#                     region (delayed puts, cbAfterDelay, clocks, At()
+#                     actions), then cbReadWriteSynch (repeated while it
+#                     schedules more zero delay work), then cbReadOnlySynch.
+#                     Value changes fire cbValueChange and Always() models
+#                     immediately, as a simulator's active region would.
+#
+#                       VpiMock::AddModule("top", "top");
+#                       vpiHandle l_clk = VpiMock::AddSignal("top.clk", 1);
+#                       VpiMock::AddSignal("top.cnt", 8);
+#                       VpiMock::AddClock(l_clk, 5);
+#                       VpiMock::Boot(vlog_startup_routines);
+#                       VpiMock::Run(1000);
+#                       VpiMock::Finish();
+#
+###############################################################################
+*/
+#ifndef VPI_MOCK_H
+#define VPI_MOCK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "vpi_user.h"
+
+using namespace std;
+
+class VpiMock
+{
+  // Public Properties (get/set)
+  public:
+  static UInt64     Time_get();
+  static bool       Finished_get();
+  // Number of callbacks the mock has made into the library.
+  static UInt64     Callbacks_get();
+
+  // Public Methods
+  public:
+  // Design, built before Boot(). Parents must be added before their children.
+  static vpiHandle  AddModule(const string & iPath, const string & iDefName = "");
+  static vpiHandle  AddSignal(const string & iPath, UInt32 iSize, Int32 iType = vpiReg,
+                              Int32 iDirection = vpiNoDirection);
+  static vpiHandle  AddArray(const string & iPath, UInt32 iWidth, UInt32 iDepth, Int32 iLeft = 0,
+                             Int32 iType = vpiRegArray);
+  // A system task call site, as if '$name(args)' was in iScope.
+  static vpiHandle  AddTaskCall(const string & iName, const vector<string> & iArgs, const string & iScope = "");
+  // Command line seen through vpi_get_vlog_info (i.e. "+test=smoke").
+  static void       SetArgs(const vector<string> & iArgs);
+
+  // Runs the startup routines (usually vlog_startup_routines), the compiletf of
+  // every call site, then cbEndOfCompile and cbStartOfSimulation.
+  static void       Boot(void (**iRoutines)());
+  // Runs the calltf of a call site now.
+  static void       Call(vpiHandle iCall);
+  // Writes a value from the rtl side (fires the value change callbacks).
+  static void       Drive(vpiHandle iObj, UInt64 iValue);
+  static void       Drive(vpiHandle iObj, const vector<UInt32> & iAval, const vector<UInt32> & iBval);
+  static UInt64     Peek(vpiHandle iObj);
+  // The clock is 0 until its first posedge at iStart + iHalfPeriod.
+  static void       AddClock(vpiHandle iClk, UInt64 iHalfPeriod, UInt64 iStart = 0);
+  // Rtl behaviour: iFn runs in the active region at iTime, or on every
+  // iEdge (vpiPosedge, vpiNegedge, anything else for any change) of iSig.
+  static void       At(UInt64 iTime, function<void()> iFn);
+  static void       Always(vpiHandle iSig, Int32 iEdge, function<void()> iFn);
+  // Advances time by iTicks. Returns false once the library called $finish.
+  static bool       Run(UInt64 iTicks);
+  // Fires cbEndOfSimulation (once).
+  static void       Finish();
+};
+
+#endif /* VPI_MOCK_H */
+
@@ -0,0 +1,443 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   checkpoint.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <cstdlib>
+
+#include "Array.h"
+#include "hierarchy.h"
+#include "Logger.h"
+#include "pli.h"
+#include "vpi_entry.h"
+
+#include "checkpoint.h"
+
+// File layout (all integers are 32-bit, host order):
+//   magic, time high, time low, scope, signal count,
+//   per signal: path, type, width, depth (0 = not a memory), low index,
+//               aval words then bval words (depth * words for a memory),
+//   client count, per client: name, byte count, bytes.
+// Strings are a length followed by the characters.
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+vector<Checkpoint::Client>  Checkpoint::s_clients;
+map<string, vector<Byte>>   Checkpoint::s_pending;
+string                      Checkpoint::s_saveFile = "";
+string                      Checkpoint::s_scope = "";
+string                      Checkpoint::s_restoreFile = "";
+const string                Checkpoint::c_magic = "TB_CHECKPOINT_V1";
+
+// ============================
+// ===**  Public Methods  **===
+// ============================
+void Checkpoint::Register(string iName, SaveFn iSave, RestoreFn iRestore)
+{
+  for(UInt32 ii=0; ii<s_clients.size(); ii++)
+  {
+    if(s_clients[ii].name == iName)
+    {
+      LOG_ERR_ENV << "Checkpoint client '" << iName << "' is already registered." << endl;
+      return;
+    }
+  }
+  Client l_client;
+  l_client.name = iName;
+  l_client.save = iSave;
+  l_client.restore = iRestore;
+  s_clients.push_back(l_client);
+
+  auto l_state = s_pending.find(iName);
+  if(l_state != s_pending.end())
+  {
+    if(iRestore)
+    {
+      iRestore(l_state->second);
+    }
+    s_pending.erase(l_state);
+  }
+}
+bool Checkpoint::Save(string iFile, string iScope)
+{
+  if(!Hierarchy::Built_get())
+  {
+    Hierarchy::Build();
+  }
+  ofstream l_out(iFile, ios::out | ios::trunc | ios::binary);
+  if(!l_out.is_open())
+  {
+    LOG_ERR_ENV << "Could not open checkpoint file '" << iFile << "' for writing." << endl;
+    return false;
+  }
+
+  Vpi::t_vpi_time l_time;
+  l_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  Vpi::vpi_get_time(NULL, &l_time);
+  putStr(l_out, c_magic);
+  putU32(l_out, l_time.high);
+  putU32(l_out, l_time.low);
+  putStr(l_out, iScope);
+
+  // The count is patched in once the records are written.
+  streampos l_countPos = l_out.tellp();
+  putU32(l_out, 0);
+  UInt32 l_count = 0;
+  vector<string> l_paths = Hierarchy::Match(iScope + ".**");
+  for(UInt32 ii=0; ii<l_paths.size(); ii++)
+  {
+    const Hierarchy::Entry * l_entry = Hierarchy::Lookup(l_paths[ii]);
+    if(l_entry == nullptr)
+    {
+      continue;
+    }
+    if((l_entry->type != Vpi::OBJECT::REG) && (l_entry->type != Vpi::OBJECT::INTEGER_VAR) &&
+       (l_entry->type != Vpi::OBJECT::REG_ARRAY) && (l_entry->type != Vpi::OBJECT::MEMORY))
+    {
+      continue;
+    }
+    if(saveSignal(l_out, l_paths[ii], l_entry->type))
+    {
+      l_count++;
+    }
+  }
+  streampos l_endPos = l_out.tellp();
+  l_out.seekp(l_countPos);
+  putU32(l_out, l_count);
+  l_out.seekp(l_endPos);
+
+  putU32(l_out, s_clients.size());
+  for(UInt32 ii=0; ii<s_clients.size(); ii++)
+  {
+    vector<Byte> l_state;
+    if(s_clients[ii].save)
+    {
+      s_clients[ii].save(l_state);
+    }
+    putStr(l_out, s_clients[ii].name);
+    putU32(l_out, l_state.size());
+    l_out.write((const char *)l_state.data(), l_state.size());
+  }
+
+  if(!l_out.good())
+  {
+    LOG_ERR_ENV << "Failed writing checkpoint file '" << iFile << "'." << endl;
+    return false;
+  }
+  LOG_MSG << "Saved " << l_count << " variables/memories under '" << iScope << "' and "
+          << s_clients.size() << " clients to '" << iFile << "'." << endl;
+  return true;
+}
+bool Checkpoint::Restore(string iFile)
+{
+  if(!Hierarchy::Built_get())
+  {
+    Hierarchy::Build();
+  }
+  ifstream l_in(iFile, ios::in | ios::binary);
+  if(!l_in.is_open())
+  {
+    LOG_ERR_ENV << "Could not open checkpoint file '" << iFile << "'." << endl;
+    return false;
+  }
+
+  string l_magic;
+  UInt32 l_high;
+  UInt32 l_low;
+  string l_scope;
+  UInt32 l_count;
+  if(!getStr(l_in, l_magic) || (l_magic != c_magic))
+  {
+    LOG_ERR_ENV << "'" << iFile << "' is not a checkpoint file." << endl;
+    return false;
+  }
+  if(!getU32(l_in, l_high) || !getU32(l_in, l_low) || !getStr(l_in, l_scope) || !getU32(l_in, l_count))
+  {
+    LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+    return false;
+  }
+  for(UInt32 ii=0; ii<l_count; ii++)
+  {
+    if(!restoreSignal(l_in, iFile))
+    {
+      return false;
+    }
+  }
+
+  if(!getU32(l_in, l_count))
+  {
+    LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+    return false;
+  }
+  for(UInt32 ii=0; ii<l_count; ii++)
+  {
+    string l_name;
+    UInt32 l_size;
+    if(!getStr(l_in, l_name) || !getU32(l_in, l_size))
+    {
+      LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+      return false;
+    }
+    vector<Byte> l_state(l_size);
+    if(!l_in.read((char *)l_state.data(), l_size))
+    {
+      LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+      return false;
+    }
+    bool l_found = false;
+    for(UInt32 kk=0; kk<s_clients.size(); kk++)
+    {
+      if(s_clients[kk].name == l_name)
+      {
+        l_found = true;
+        if(s_clients[kk].restore)
+        {
+          s_clients[kk].restore(l_state);
+        }
+        break;
+      }
+    }
+    if(!l_found)
+    {
+      // Most clients register from $tb_build, after the restore.
+      s_pending[l_name] = l_state;
+    }
+  }
+  if(s_pending.size() > 0)
+  {
+    vpi_entry::_s_EndOfSimulation += s_unclaimed;
+  }
+
+  UInt64 l_time = ((UInt64)l_high << 32) | l_low;
+  LOG_MSG << "Restored '" << l_scope << "' from '" << iFile << "' (saved at " << l_time << ")." << endl;
+  return true;
+}
+void Checkpoint::Arm()
+{
+  vector<string> * l_args = Pli::GetCommandLineArgs();
+  UInt64 l_saveTime = 0;
+  for(UInt32 ii=0; ii<l_args->size(); ii++)
+  {
+    const string & l_arg = l_args->at(ii);
+    if(l_arg.compare(0, 17, "+checkpoint_save=") == 0)
+    {
+      s_saveFile = l_arg.substr(17);
+    }
+    else if(l_arg.compare(0, 17, "+checkpoint_time=") == 0)
+    {
+      l_saveTime = strtoull(l_arg.c_str() + 17, nullptr, 0);
+    }
+    else if(l_arg.compare(0, 18, "+checkpoint_scope=") == 0)
+    {
+      s_scope = l_arg.substr(18);
+    }
+    else if(l_arg.compare(0, 20, "+checkpoint_restore=") == 0)
+    {
+      s_restoreFile = l_arg.substr(20);
+    }
+  }
+  delete l_args;
+
+  if(s_restoreFile.size() > 0)
+  {
+    registerCB(Vpi::CB_REASON::READ_WRITE_SYNCH, 0, s_restoreCB);
+  }
+  if(s_saveFile.size() > 0)
+  {
+    registerCB(Vpi::CB_REASON::AFTER_DELAY, l_saveTime, s_saveDelayCB);
+  }
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool Checkpoint::saveSignal(ofstream & iOut, const string & iPath, Vpi::OBJECT iType)
+{
+  vpiHandle l_hndl = Hierarchy::Find(iPath);
+  if(l_hndl == NULL)
+  {
+    return false;
+  }
+  vector<UInt32> l_aval;
+  vector<UInt32> l_bval;
+  UInt32 l_width;
+  UInt32 l_depth = 0;
+  Int32 l_low = 0;
+  if((iType == Vpi::OBJECT::REG) || (iType == Vpi::OBJECT::INTEGER_VAR))
+  {
+    Pli::VectorContext l_ctx;
+    if(!Pli::InitVectorContext(l_hndl, Pli::GetSize(l_hndl), l_ctx))
+    {
+      return false;
+    }
+    l_width = l_ctx.size;
+    l_aval.resize(l_ctx.nbWords);
+    l_bval.resize(l_ctx.nbWords);
+    Pli::GetVectorWords(l_ctx, l_aval.data(), l_bval.data());
+  }
+  else
+  {
+    Array l_arr(iPath);
+    if((l_arr.Get_Depth() == 0) || !l_arr.Read(l_arr.Get_LowIndex(), l_arr.Get_Depth(), l_aval, &l_bval))
+    {
+      return false;
+    }
+    l_width = l_arr.Get_Width();
+    l_depth = l_arr.Get_Depth();
+    l_low = l_arr.Get_LowIndex();
+  }
+
+  putStr(iOut, iPath);
+  putU32(iOut, (UInt32)iType);
+  putU32(iOut, l_width);
+  putU32(iOut, l_depth);
+  putU32(iOut, (UInt32)l_low);
+  iOut.write((const char *)l_aval.data(), l_aval.size() * sizeof(UInt32));
+  iOut.write((const char *)l_bval.data(), l_bval.size() * sizeof(UInt32));
+  return true;
+}
+bool Checkpoint::restoreSignal(ifstream & iIn, const string & iFile)
+{
+  string l_path;
+  UInt32 l_type;
+  UInt32 l_width;
+  UInt32 l_depth;
+  UInt32 l_low;
+  if(!getStr(iIn, l_path) || !getU32(iIn, l_type) || !getU32(iIn, l_width) ||
+     !getU32(iIn, l_depth) || !getU32(iIn, l_low) || (l_width == 0))
+  {
+    LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+    return false;
+  }
+  UInt32 l_words = ((l_width - 1) / 32 + 1) * ((l_depth == 0) ? 1 : l_depth);
+  vector<UInt32> l_aval(l_words);
+  vector<UInt32> l_bval(l_words);
+  if(!iIn.read((char *)l_aval.data(), l_words * sizeof(UInt32)) ||
+     !iIn.read((char *)l_bval.data(), l_words * sizeof(UInt32)))
+  {
+    LOG_ERR_ENV << "Checkpoint file '" << iFile << "' is truncated." << endl;
+    return false;
+  }
+
+  // A design that changed since the save only loses the mismatching objects.
+  vpiHandle l_hndl = Hierarchy::Find(l_path);
+  if(l_hndl == NULL)
+  {
+    LOG_WRN_ENV << "Checkpoint object '" << l_path << "' is not in the design, skipped." << endl;
+    return true;
+  }
+  if(l_depth == 0)
+  {
+    Pli::VectorContext l_ctx;
+    if(!Pli::InitVectorContext(l_hndl, Pli::GetSize(l_hndl), l_ctx) || (l_ctx.size != l_width))
+    {
+      LOG_WRN_ENV << "Checkpoint object '" << l_path << "' changed size, skipped." << endl;
+      return true;
+    }
+    Pli::SetVectorWords(l_ctx, l_aval.data(), l_bval.data());
+  }
+  else
+  {
+    Array l_arr(l_path);
+    if((l_arr.Get_Width() != l_width) || (l_arr.Get_Depth() != l_depth) || (l_arr.Get_LowIndex() != (Int32)l_low))
+    {
+      LOG_WRN_ENV << "Checkpoint memory '" << l_path << "' changed shape, skipped." << endl;
+      return true;
+    }
+    l_arr.Write((Int32)l_low, l_depth, l_aval, &l_bval);
+  }
+  return true;
+}
+void Checkpoint::registerCB(Vpi::CB_REASON iReason, UInt64 iDelay, Int32 (*iRoutine)(Vpi::t_cb_data *))
+{
+  Vpi::t_cb_data l_cb_data;
+  Vpi::t_vpi_time l_vpi_time;
+
+  l_vpi_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  l_vpi_time.high = (UInt32)(iDelay >> 32);
+  l_vpi_time.low = (UInt32)iDelay;
+  l_vpi_time.real = 0;
+
+  l_cb_data.reason = iReason;
+  l_cb_data.cb_rtn = iRoutine;
+  l_cb_data.obj = NULL;
+  l_cb_data.time = &l_vpi_time;
+  l_cb_data.value = NULL;
+  l_cb_data.index = 0;
+  l_cb_data.user_data = 0;
+
+  if(Vpi::vpi_register_cb(&l_cb_data) == NULL)
+  {
+    LOG_ERR_ENV << "Could not register a checkpoint callback (reason " << (Int32)iReason << ")." << endl;
+  }
+}
+Int32 Checkpoint::s_saveDelayCB(Vpi::t_cb_data * UNUSED(iData))
+{
+  // Wait for the values of this timestep to settle.
+  registerCB(Vpi::CB_REASON::READ_ONLY_SYNCH, 0, s_saveCB);
+  return 0;
+}
+Int32 Checkpoint::s_saveCB(Vpi::t_cb_data * UNUSED(iData))
+{
+  string l_scope = s_scope;
+  if((l_scope.size() == 0) && (vpi_entry::TopModule_get() != NULL))
+  {
+    l_scope = Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, vpi_entry::TopModule_get());
+  }
+  if(l_scope.size() == 0)
+  {
+    LOG_ERR_ENV << "No checkpoint scope, pass +checkpoint_scope=<path>." << endl;
+    return 0;
+  }
+  Save(s_saveFile, l_scope);
+  return 0;
+}
+Int32 Checkpoint::s_restoreCB(Vpi::t_cb_data * UNUSED(iData))
+{
+  Restore(s_restoreFile);
+  return 0;
+}
+void Checkpoint::s_unclaimed()
+{
+  for(auto ii=s_pending.begin(); ii!=s_pending.end(); ii++)
+  {
+    LOG_WRN_ENV << "Checkpoint client '" << ii->first << "' never registered, its state was dropped." << endl;
+  }
+  s_pending.clear();
+}
+void Checkpoint::putU32(ofstream & iOut, UInt32 iVal)
+{
+  iOut.write((const char *)&iVal, sizeof(iVal));
+}
+void Checkpoint::putStr(ofstream & iOut, const string & iStr)
+{
+  putU32(iOut, iStr.size());
+  iOut.write(iStr.data(), iStr.size());
+}
+bool Checkpoint::getU32(ifstream & iIn, UInt32 & oVal)
+{
+  return (bool)iIn.read((char *)&oVal, sizeof(oVal));
+}
+bool Checkpoint::getStr(ifstream & iIn, string & oStr)
+{
+  UInt32 l_size;
+  if(!getU32(iIn, l_size))
+  {
+    return false;
+  }
+  oStr.resize(l_size);
+  return (bool)iIn.read(&oStr[0], l_size);
+}
+
@@ -0,0 +1,98 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   checkpoint.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Saves the state of a warmed up DUT so later runs can
+#                     start from it instead of replaying the warm-up.
+#                     Every reg, integer and memory under a scope (taken from
+#                     the hierarchy index) is written to a binary file along
+#                     with the state of the registered C++ clients.
+#                     Nets are not saved, they follow from the variables.
+#
+#                     +checkpoint_save=<file>     Save at +checkpoint_time.
+#                     +checkpoint_time=<ticks>    Simulation ticks, default 0.
+#                     +checkpoint_scope=<path>    Default: the top module.
+#                     +checkpoint_restore=<file>  Write it back at time zero
+#                                                 (ReadWriteSynch, after the
+#                                                 initial blocks ran).
+#
+#                     Components keep their own state in the file with:
+#                       Checkpoint::Register("sb0", saveFn, restoreFn);
+#                     The signals are restored at time zero, before $tb_build
+#                     built the components. A client's state is held until
+#                     it registers, restoreFn runs from Register() then
+#                     (right away for a client registered before the
+#                     restore). State no client claimed by the end of the
+#                     simulation is reported.
+#
+###############################################################################
+*/
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "vpi.h"
+
+using namespace std;
+
+class Checkpoint
+{
+  // Nested Classes
+  public:
+  typedef function<void(vector<Byte> &)>        SaveFn;
+  typedef function<void(const vector<Byte> &)>  RestoreFn;
+
+  private:
+  struct Client
+  {
+    string      name;
+    SaveFn      save;
+    RestoreFn   restore;
+  };
+
+  // Private Members
+  private:
+  static vector<Client> s_clients;
+  static map<string, vector<Byte>>  s_pending;  // Restored, client not registered yet.
+  static string         s_saveFile;
+  static string         s_scope;
+  static string         s_restoreFile;
+  static const string   c_magic;
+
+  // Public Methods
+  public:
+  static void   Register(string iName, SaveFn iSave, RestoreFn iRestore);
+  static bool   Save(string iFile, string iScope);
+  static bool   Restore(string iFile);
+  static void   Arm();
+
+  // Private Methods
+  private:
+  static bool   saveSignal(ofstream & iOut, const string & iPath, Vpi::OBJECT iType);
+  static bool   restoreSignal(ifstream & iIn, const string & iFile);
+  static void   registerCB(Vpi::CB_REASON iReason, UInt64 iDelay, Int32 (*iRoutine)(Vpi::t_cb_data *));
+  static Int32  s_saveDelayCB(Vpi::t_cb_data * iData);
+  static Int32  s_saveCB(Vpi::t_cb_data * iData);
+  static Int32  s_restoreCB(Vpi::t_cb_data * iData);
+  static void   s_unclaimed();
+  static void   putU32(ofstream & iOut, UInt32 iVal);
+  static void   putStr(ofstream & iOut, const string & iStr);
+  static bool   getU32(ifstream & iIn, UInt32 & oVal);
+  static bool   getStr(ifstream & iIn, string & oStr);
+};
+
+#endif /* CHECKPOINT_H */
+
@@ -0,0 +1,522 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   hierarchy.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <unistd.h>
+
+#include "Logger.h"
+#include "pli.h"
+#include "vpi_entry.h"
+
+#include "hierarchy.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+unordered_map<string, Hierarchy::Entry> Hierarchy::s_index;
+vector<string>                          Hierarchy::s_sorted;
+bool                                    Hierarchy::s_built = false;
+bool                                    Hierarchy::s_fromCache = false;
+unordered_set<string>                   Hierarchy::s_resolved;
+const string                            Hierarchy::c_cacheTag = "HIER_INDEX_V1";
+
+// ============================
+// ===**  Public Methods  **===
+// ============================
+bool Hierarchy::Build()
+{
+  Clear();
+  UInt64 l_hash = 0;
+  string l_cacheFile = cacheWanted() ? cacheFile(l_hash) : "";
+  if((l_cacheFile != "") && loadCache(l_cacheFile, l_hash))
+  {
+    sortNames();
+    s_built = true;
+    s_fromCache = true;
+    LOG_DEBUG << "Hierarchy index loaded from '" << l_cacheFile << "' with "
+              << s_index.size() << " objects." << endl;
+    return true;
+  }
+
+  vpiHandle l_topIter = Vpi::vpi_iterate(Vpi::OBJECT::MODULE, NULL);
+  if(l_topIter == NULL)
+  {
+    LOG_ERR_ENV << "No top-level modules found, hierarchy index not built." << endl;
+    return false;
+  }
+  vpiHandle l_top;
+  while((l_top = Vpi::vpi_scan(l_topIter)) != NULL)
+  {
+    walkScope(l_top);
+  }
+
+  sortNames();
+  s_built = true;
+  LOG_DEBUG << "Hierarchy index built with " << s_index.size() << " objects." << endl;
+  if(l_cacheFile != "")
+  {
+    saveCache(l_cacheFile, l_hash);
+  }
+  return true;
+}
+void Hierarchy::Clear()
+{
+  s_index.clear();
+  s_sorted.clear();
+  s_resolved.clear();
+  s_built = false;
+  s_fromCache = false;
+}
+vpiHandle Hierarchy::Find(const string & iName)
+{
+  const Entry * l_entry = Lookup(iName);
+  if(l_entry == nullptr)
+  {
+    return NULL;
+  }
+  return l_entry->hndl;
+}
+const Hierarchy::Entry * Hierarchy::Lookup(const string & iName)
+{
+  unordered_map<string, Entry>::iterator l_it = s_index.find(iName);
+  if(l_it == s_index.end())
+  {
+    // Names may also be given relative to the top module ($tb_build argument).
+    vpiHandle l_top = vpi_entry::TopModule_get();
+    if(l_top == NULL)
+    {
+      return nullptr;
+    }
+    string l_full = string(Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, l_top)) + "." + iName;
+    l_it = s_index.find(l_full);
+    if(l_it == s_index.end())
+    {
+      return nullptr;
+    }
+  }
+
+  if(l_it->second.hndl == NULL)
+  {
+    // Loaded from the cache: the first lookup in a scope resolves all of it.
+    size_t l_dot = l_it->first.rfind('.');
+    if(l_dot != string::npos)
+    {
+      resolveScope(l_it->first.substr(0, l_dot));
+    }
+    if(l_it->second.hndl == NULL)
+    {
+      // A top module, or a name the scan didn't give back (i.e. escaped).
+      l_it->second.hndl = Vpi::vpi_handle_by_name(l_it->first.c_str(), NULL);
+    }
+    if(l_it->second.hndl == NULL)
+    {
+      LOG_WRN_ENV << "Cached object '" << l_it->first << "' could not be resolved." << endl;
+      return nullptr;
+    }
+  }
+  return &l_it->second;
+}
+vector<string> Hierarchy::Match(const string & iPattern)
+{
+  vector<string> l_retVal;
+
+  // Only paths sharing the literal prefix can match, so start the
+  // scan there instead of at the beginning of the index.
+  size_t l_wild = iPattern.find_first_of("*?");
+  string l_prefix = iPattern.substr(0, l_wild);
+  if(l_wild == string::npos)
+  {
+    if(s_index.count(iPattern) > 0)
+    {
+      l_retVal.push_back(iPattern);
+    }
+    return l_retVal;
+  }
+
+  vector<string>::iterator l_it = lower_bound(s_sorted.begin(), s_sorted.end(), l_prefix);
+  for(; l_it != s_sorted.end(); l_it++)
+  {
+    if(l_it->compare(0, l_prefix.size(), l_prefix) != 0)
+    {
+      break;
+    }
+    if(globMatch(iPattern.c_str() + l_prefix.size(), l_it->c_str() + l_prefix.size()))
+    {
+      l_retVal.push_back(*l_it);
+    }
+  }
+  return l_retVal;
+}
+vector<string> Hierarchy::MatchRegex(const string & iRegex)
+{
+  vector<string> l_retVal;
+  regex l_re;
+  try
+  {
+    l_re.assign(iRegex);
+  }
+  catch(const regex_error & e)
+  {
+    LOG_ERR_ENV << "Invalid regex '" << iRegex << "' (" << e.what() << ")." << endl;
+    return l_retVal;
+  }
+  for(UInt32 ii=0; ii<s_sorted.size(); ii++)
+  {
+    if(regex_match(s_sorted[ii], l_re))
+    {
+      l_retVal.push_back(s_sorted[ii]);
+    }
+  }
+  return l_retVal;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+void Hierarchy::walkScope(vpiHandle iScope)
+{
+  Vpi::OBJECT l_type = (Vpi::OBJECT)Vpi::vpi_get(Vpi::PROPERTY::TYPE, iScope);
+  add(iScope, l_type);
+
+  addObjects(iScope, Vpi::OBJECT::NET);
+  addObjects(iScope, Vpi::OBJECT::REG);
+  addObjects(iScope, Vpi::OBJECT::INTEGER_VAR);
+  addObjects(iScope, Vpi::OBJECT::NET_ARRAY);
+  addObjects(iScope, Vpi::OBJECT::REG_ARRAY);
+  addObjects(iScope, Vpi::OBJECT::MEMORY);
+  if(l_type == Vpi::OBJECT::MODULE)
+  {
+    addPorts(iScope);
+  }
+
+  // Modules, generate scopes, named blocks, tasks & functions.
+  vpiHandle l_iter = Vpi::vpi_iterate(Vpi::OBJECT::INTERNAL_SCOPE, iScope);
+  if(l_iter == NULL)
+  {
+    return;
+  }
+  vpiHandle l_child;
+  while((l_child = Vpi::vpi_scan(l_iter)) != NULL)
+  {
+    walkScope(l_child);
+  }
+}
+void Hierarchy::addObjects(vpiHandle iScope, Vpi::OBJECT iType)
+{
+  vpiHandle l_iter = Vpi::vpi_iterate(iType, iScope);
+  if(l_iter == NULL)
+  {
+    return;
+  }
+  vpiHandle l_obj;
+  while((l_obj = Vpi::vpi_scan(l_iter)) != NULL)
+  {
+    add(l_obj, iType);
+  }
+}
+void Hierarchy::addPorts(vpiHandle iScope)
+{
+  vpiHandle l_iter = Vpi::vpi_iterate(Vpi::OBJECT::PORT, iScope);
+  if(l_iter == NULL)
+  {
+    return;
+  }
+  string l_scopeName = Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, iScope);
+  vpiHandle l_port;
+  while((l_port = Vpi::vpi_scan(l_iter)) != NULL)
+  {
+    char * l_name = Vpi::vpi_get_str(Vpi::PROPERTY::NAME, l_port);
+    if(l_name == NULL)
+    {
+      continue;
+    }
+    // The port's net/reg of the same name was added by addObjects.
+    unordered_map<string, Entry>::iterator l_it = s_index.find(l_scopeName + "." + l_name);
+    if(l_it != s_index.end())
+    {
+      l_it->second.direction = (Vpi::DIRECTION)Vpi::vpi_get(Vpi::PROPERTY::DIRECTION, l_port);
+    }
+  }
+}
+void Hierarchy::resolveScope(const string & iScope)
+{
+  if(!s_resolved.insert(iScope).second)
+  {
+    return;
+  }
+  vpiHandle l_scope = Find(iScope);
+  if(l_scope == NULL)
+  {
+    return;
+  }
+  resolveObjects(l_scope, Vpi::OBJECT::NET);
+  resolveObjects(l_scope, Vpi::OBJECT::REG);
+  resolveObjects(l_scope, Vpi::OBJECT::INTEGER_VAR);
+  resolveObjects(l_scope, Vpi::OBJECT::NET_ARRAY);
+  resolveObjects(l_scope, Vpi::OBJECT::REG_ARRAY);
+  resolveObjects(l_scope, Vpi::OBJECT::MEMORY);
+  resolveObjects(l_scope, Vpi::OBJECT::INTERNAL_SCOPE);
+}
+void Hierarchy::resolveObjects(vpiHandle iScope, Vpi::OBJECT iType)
+{
+  vpiHandle l_iter = Vpi::vpi_iterate(iType, iScope);
+  if(l_iter == NULL)
+  {
+    return;
+  }
+  vpiHandle l_obj;
+  while((l_obj = Vpi::vpi_scan(l_iter)) != NULL)
+  {
+    char * l_name = Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, l_obj);
+    if(l_name == NULL)
+    {
+      continue;
+    }
+    unordered_map<string, Entry>::iterator l_it = s_index.find(l_name);
+    if((l_it != s_index.end()) && (l_it->second.hndl == NULL))
+    {
+      l_it->second.hndl = l_obj;
+    }
+  }
+}
+void Hierarchy::add(vpiHandle iHndl, Vpi::OBJECT iType)
+{
+  char * l_name = Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, iHndl);
+  if(l_name == NULL)
+  {
+    return;
+  }
+  Entry l_entry;
+  l_entry.hndl = iHndl;
+  l_entry.type = iType;
+  l_entry.size = 0;
+  l_entry.direction = Vpi::DIRECTION::NO_DIR;
+  if((iType != Vpi::OBJECT::MODULE) && (iType != Vpi::OBJECT::GEN_SCOPE) &&
+     (iType != Vpi::OBJECT::NAMED_BEGIN) && (iType != Vpi::OBJECT::NAMED_FORK) &&
+     (iType != Vpi::OBJECT::TASK) && (iType != Vpi::OBJECT::FUNCTION))
+  {
+    l_entry.size = Vpi::vpi_get(Vpi::PROPERTY::SIZE, iHndl);
+  }
+  // Some simulators return arrays under more than one type, keep the first.
+  s_index.insert(make_pair(string(l_name), l_entry));
+}
+bool Hierarchy::globMatch(const char * iPattern, const char * iName)
+{
+  while(*iPattern != '\0')
+  {
+    if((iPattern[0] == '*') && (iPattern[1] == '*'))
+    {
+      // Any characters, including '.'.
+      iPattern += 2;
+      for(const char * l_try = iName; ; l_try++)
+      {
+        if(globMatch(iPattern, l_try))
+        {
+          return true;
+        }
+        if(*l_try == '\0')
+        {
+          return false;
+        }
+      }
+    }
+    else if(*iPattern == '*')
+    {
+      // Any characters within this level.
+      iPattern++;
+      for(const char * l_try = iName; ; l_try++)
+      {
+        if(globMatch(iPattern, l_try))
+        {
+          return true;
+        }
+        if((*l_try == '\0') || (*l_try == '.'))
+        {
+          return false;
+        }
+      }
+    }
+    else if(*iPattern == '?')
+    {
+      if((*iName == '\0') || (*iName == '.'))
+      {
+        return false;
+      }
+    }
+    else if(*iPattern != *iName)
+    {
+      return false;
+    }
+    iPattern++;
+    iName++;
+  }
+  return *iName == '\0';
+}
+void Hierarchy::sortNames()
+{
+  s_sorted.clear();
+  s_sorted.reserve(s_index.size());
+  for(unordered_map<string, Entry>::iterator it = s_index.begin(); it != s_index.end(); it++)
+  {
+    s_sorted.push_back(it->first);
+  }
+  sort(s_sorted.begin(), s_sorted.end());
+}
+bool Hierarchy::cacheWanted()
+{
+  vector<string> * l_args = Pli::GetCommandLineArgs();
+  bool l_retVal = (find(l_args->begin(), l_args->end(), "+no_hier_cache") == l_args->end());
+  delete l_args;
+  return l_retVal;
+}
+string Hierarchy::cacheFile(UInt64 & oHash)
+{
+  // The compiled image is the (first) .vvp file on the simulator command line.
+  vector<string> * l_args = Pli::GetCommandLineArgs();
+  string l_image = "";
+  for(UInt32 ii=0; ii<l_args->size(); ii++)
+  {
+    const string & l_arg = l_args->at(ii);
+    if((l_arg.size() > 4) && (l_arg.compare(l_arg.size() - 4, 4, ".vvp") == 0))
+    {
+      l_image = l_arg;
+      break;
+    }
+  }
+  delete l_args;
+  if(l_image == "")
+  {
+    LOG_DEBUG << "No compiled image on the command line, hierarchy cache disabled." << endl;
+    return "";
+  }
+  if(!hashFile(l_image, oHash))
+  {
+    return "";
+  }
+
+  string l_dir;
+  const char * l_dumpDir = getenv("DUMP_DIR");
+  if(l_dumpDir != NULL)
+  {
+    l_dir = l_dumpDir;
+  }
+  else
+  {
+    // Fall back to where the image lives.
+    size_t l_slash = l_image.find_last_of('/');
+    l_dir = (l_slash == string::npos) ? "." : l_image.substr(0, l_slash);
+  }
+
+  stringstream l_name;
+  l_name << l_dir << "/hier_index_" << hex << oHash << ".cache";
+  return l_name.str();
+}
+bool Hierarchy::hashFile(const string & iPath, UInt64 & oHash)
+{
+  ifstream l_file(iPath, ios::in | ios::binary);
+  if(!l_file.is_open())
+  {
+    LOG_WRN_ENV << "Could not open '" << iPath << "' to hash it." << endl;
+    return false;
+  }
+  // 64-bit FNV-1a.
+  oHash = 0xcbf29ce484222325ULL;
+  char l_buf[65536];
+  while(l_file)
+  {
+    l_file.read(l_buf, sizeof(l_buf));
+    streamsize l_nb = l_file.gcount();
+    for(streamsize ii=0; ii<l_nb; ii++)
+    {
+      oHash ^= (unsigned char)l_buf[ii];
+      oHash *= 0x100000001b3ULL;
+    }
+  }
+  return true;
+}
+bool Hierarchy::loadCache(const string & iFile, UInt64 iHash)
+{
+  ifstream l_file(iFile);
+  if(!l_file.is_open())
+  {
+    return false;
+  }
+
+  // Header: tag, image hash, entry count.
+  string l_tag;
+  UInt64 l_hash = 0;
+  UInt32 l_count = 0;
+  l_file >> l_tag >> hex >> l_hash >> dec >> l_count;
+  if(!l_file || (l_tag != c_cacheTag) || (l_hash != iHash))
+  {
+    LOG_WRN_ENV << "Hierarchy cache '" << iFile << "' is stale or invalid, rebuilding." << endl;
+    return false;
+  }
+
+  // Entries: type size direction full_path (the path runs to the end of line).
+  for(UInt32 ii=0; ii<l_count; ii++)
+  {
+    Int32 l_type;
+    Int32 l_dir;
+    Entry l_entry;
+    string l_path;
+    l_file >> l_type >> l_entry.size >> l_dir;
+    l_file.get();
+    getline(l_file, l_path);
+    if(!l_file || (l_path == ""))
+    {
+      LOG_WRN_ENV << "Hierarchy cache '" << iFile << "' is truncated, rebuilding." << endl;
+      s_index.clear();
+      return false;
+    }
+    l_entry.hndl = NULL;
+    l_entry.type = (Vpi::OBJECT)l_type;
+    l_entry.direction = (Vpi::DIRECTION)l_dir;
+    s_index.insert(make_pair(l_path, l_entry));
+  }
+  return true;
+}
+void Hierarchy::saveCache(const string & iFile, UInt64 iHash)
+{
+  // Many seeds of one compile may start together. Write a private file
+  // and rename it into place so a reader never sees a partial cache.
+  stringstream l_tmp;
+  l_tmp << iFile << "." << getpid();
+  ofstream l_file(l_tmp.str(), ios::out | ios::trunc);
+  if(!l_file.is_open())
+  {
+    LOG_WRN_ENV << "Could not write the hierarchy cache '" << l_tmp.str() << "'." << endl;
+    return;
+  }
+  l_file << c_cacheTag << " " << hex << iHash << dec << " " << s_index.size() << endl;
+  for(UInt32 ii=0; ii<s_sorted.size(); ii++)
+  {
+    const Entry & l_entry = s_index[s_sorted[ii]];
+    l_file << (Int32)l_entry.type << " " << l_entry.size << " "
+           << (Int32)l_entry.direction << " " << s_sorted[ii] << endl;
+  }
+  l_file.close();
+  if(rename(l_tmp.str().c_str(), iFile.c_str()) != 0)
+  {
+    LOG_WRN_ENV << "Could not move the hierarchy cache into '" << iFile << "'." << endl;
+    remove(l_tmp.str().c_str());
+  }
+}
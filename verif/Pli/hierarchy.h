@@ -0,0 +1,106 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   hierarchy.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   In-memory index of the design hierarchy.
+#                     Built once at the end of compilation by walking every
+#                     scope (modules, generate/named blocks, tasks) and the
+#                     nets, regs, integers and arrays in them. Name lookups
+#                     then resolve from a hash instead of vpi_handle_by_name.
+#
+#                     Patterns (Match):
+#                       *   any characters within one path level
+#                       ?   one character within one path level
+#                       **  any characters across path levels
+#                     i.e. "top.dut0.sync_*.wr_*"
+#                     MatchRegex takes an ECMAScript regex on the full path.
+#
+#                     The index (paths, types, sizes, port directions) is
+#                     saved to $DUMP_DIR/hier_index_<hash>.cache, where hash
+#                     is taken over the compiled image (a.vvp). Runs of the
+#                     same compile load it instead of walking the design;
+#                     handles are then resolved on first lookup. The first
+#                     lookup in a scope scans that scope once (its objects
+#                     and child scopes, not below) and resolves every
+#                     handle found, so only the scopes a run uses are
+#                     walked and only names the scan can't give back (top
+#                     modules, escaped names) use vpi_handle_by_name.
+#                     Pass +no_hier_cache to always walk the design.
+#
+###############################################################################
+*/
+#ifndef HIERARCHY_H
+#define HIERARCHY_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common.h"
+#include "vpi.h"
+
+using namespace std;
+
+class Hierarchy
+{
+  // Nested Classes
+  public:
+  struct Entry
+  {
+    vpiHandle       hndl;       // NULL until first lookup when loaded from the cache.
+    Vpi::OBJECT     type;
+    Int32           size;       // vpiSize, 0 for scopes.
+    Vpi::DIRECTION  direction;  // NO_DIR unless the object is a module port.
+  };
+
+  // Private Members
+  private:
+  static unordered_map<string, Entry> s_index;
+  static vector<string>               s_sorted;   // Full paths in order, for pattern scans.
+  static bool                         s_built;
+  static bool                         s_fromCache;
+  static unordered_set<string>        s_resolved; // Cache loaded scopes already scanned.
+  static const string                 c_cacheTag;
+
+  // Public Properties (get/set)
+  public:
+  static bool   Built_get()     { return s_built; }
+  static bool   FromCache_get() { return s_fromCache; }
+  static UInt32 Size_get()      { return s_index.size(); }
+
+  // Public Methods
+  public:
+  static bool           Build();
+  static void           Clear();
+  static vpiHandle      Find(const string & iName);
+  static const Entry *  Lookup(const string & iName);
+  static vector<string> Match(const string & iPattern);
+  static vector<string> MatchRegex(const string & iRegex);
+
+  // Private Methods
+  private:
+  static void   walkScope(vpiHandle iScope);
+  static void   addObjects(vpiHandle iScope, Vpi::OBJECT iType);
+  static void   addPorts(vpiHandle iScope);
+  static void   resolveScope(const string & iScope);
+  static void   resolveObjects(vpiHandle iScope, Vpi::OBJECT iType);
+  static void   add(vpiHandle iHndl, Vpi::OBJECT iType);
+  static bool   globMatch(const char * iPattern, const char * iName);
+  static void   sortNames();
+  static bool   cacheWanted();
+  static string cacheFile(UInt64 & oHash);
+  static bool   hashFile(const string & iPath, UInt64 & oHash);
+  static bool   loadCache(const string & iFile, UInt64 iHash);
+  static void   saveCache(const string & iFile, UInt64 iHash);
+};
+
+#endif /* HIERARCHY_H */
+
@@ -0,0 +1,375 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   ifgen.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+#include "Logger.h"
+#include "pli.h"
+
+#include "ifgen.h"
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+bool IfGen::Requested()
+{
+  vector<string> * l_args = Pli::GetCommandLineArgs();
+  bool l_retVal = false;
+  for(UInt32 ii=0; ii<l_args->size(); ii++)
+  {
+    if(l_args->at(ii).compare(0, 7, "+ifgen=") == 0)
+    {
+      l_retVal = true;
+      break;
+    }
+  }
+  delete l_args;
+  return l_retVal;
+}
+bool IfGen::Run()
+{
+  vector<string> l_instances;
+  string l_file;
+  if(!getArgs(l_instances, l_file))
+  {
+    return false;
+  }
+  if(!Hierarchy::Built_get())
+  {
+    Hierarchy::Build();
+  }
+
+  ofstream l_out(l_file, ios::out | ios::trunc);
+  if(!l_out.is_open())
+  {
+    LOG_ERR_ENV << "Could not open '" << l_file << "' for the generated interface." << endl;
+    return false;
+  }
+  size_t l_slash = l_file.find_last_of('/');
+  string l_guard = identifier((l_slash == string::npos) ? l_file : l_file.substr(l_slash + 1));
+  transform(l_guard.begin(), l_guard.end(), l_guard.begin(), ::toupper);
+
+  l_out << "// Generated by +ifgen at end of compilation. Do not edit, regenerate" << endl;
+  l_out << "// it when the rtl ports change." << endl;
+  l_out << "#ifndef " << l_guard << endl;
+  l_out << "#define " << l_guard << endl;
+  l_out << endl;
+  l_out << "#include <string>" << endl;
+  l_out << endl;
+  l_out << "#include \"BitVector.h\"" << endl;
+  l_out << "#include \"Common.h\"" << endl;
+  l_out << "#include \"Integer.h\"" << endl;
+  l_out << "#include \"Logger.h\"" << endl;
+  l_out << "#include \"Logic.h\"" << endl;
+  l_out << endl;
+  l_out << "using namespace std;" << endl;
+  l_out << endl;
+
+  bool l_retVal = true;
+  for(UInt32 ii=0; ii<l_instances.size(); ii++)
+  {
+    vector<Signal> l_signals;
+    if(!collect(l_instances[ii], l_signals))
+    {
+      l_retVal = false;
+      continue;
+    }
+    emitClass(l_out, l_instances[ii], l_signals);
+    LOG_MSG << "Generated the interface of '" << l_instances[ii] << "' ("
+            << l_signals.size() << " signals)." << endl;
+  }
+  l_out << "#endif /* " << l_guard << " */" << endl;
+  LOG_MSG << "Wrote the generated interface to '" << l_file << "'." << endl;
+  return l_retVal;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool IfGen::getArgs(vector<string> & oInstances, string & oFile)
+{
+  oFile = "";
+  vector<string> * l_args = Pli::GetCommandLineArgs();
+  for(UInt32 ii=0; ii<l_args->size(); ii++)
+  {
+    const string & l_arg = l_args->at(ii);
+    if(l_arg.compare(0, 7, "+ifgen=") == 0)
+    {
+      stringstream l_names(l_arg.substr(7));
+      string l_name;
+      while(getline(l_names, l_name, ','))
+      {
+        if(l_name.size() > 0)
+        {
+          oInstances.push_back(l_name);
+        }
+      }
+    }
+    else if(l_arg.compare(0, 11, "+ifgen_out=") == 0)
+    {
+      oFile = l_arg.substr(11);
+    }
+  }
+  delete l_args;
+
+  if(oInstances.size() == 0)
+  {
+    LOG_ERR_ENV << "+ifgen needs at least one instance (i.e. +ifgen=top.dut0)." << endl;
+    return false;
+  }
+  if(oFile.size() == 0)
+  {
+    const char * l_dumpDir = getenv("DUMP_DIR");
+    oFile = string((l_dumpDir != NULL) ? l_dumpDir : ".") + "/dut_if.h";
+  }
+  return true;
+}
+bool IfGen::collect(const string & iInstance, vector<Signal> & oSignals)
+{
+  const Hierarchy::Entry * l_inst = Hierarchy::Lookup(iInstance);
+  if((l_inst == nullptr) || (l_inst->type != Vpi::OBJECT::MODULE))
+  {
+    LOG_ERR_ENV << "'" << iInstance << "' is not a module instance." << endl;
+    return false;
+  }
+
+  vector<string> l_paths = Hierarchy::Match(iInstance + ".*");
+  for(UInt32 ii=0; ii<l_paths.size(); ii++)
+  {
+    const Hierarchy::Entry * l_entry = Hierarchy::Lookup(l_paths[ii]);
+    if(l_entry == nullptr)
+    {
+      continue;
+    }
+    if((l_entry->type != Vpi::OBJECT::NET) && (l_entry->type != Vpi::OBJECT::REG) &&
+       (l_entry->type != Vpi::OBJECT::INTEGER_VAR))
+    {
+      // Scopes and arrays (see Array) have no single value to bind.
+      continue;
+    }
+    if(l_entry->size <= 0)
+    {
+      continue;
+    }
+    Signal l_sig;
+    l_sig.rtlName = l_paths[ii].substr(iInstance.size() + 1);
+    l_sig.name = identifier(l_sig.rtlName);
+    l_sig.type = l_entry->type;
+    l_sig.size = l_entry->size;
+    l_sig.direction = l_entry->direction;
+    oSignals.push_back(l_sig);
+  }
+  // Ports first, in index (name) order.
+  stable_partition(oSignals.begin(), oSignals.end(),
+                   [](const Signal & iSig) { return iSig.direction != Vpi::DIRECTION::NO_DIR; });
+  return true;
+}
+void IfGen::emitClass(ofstream & iOut, const string & iInstance, const vector<Signal> & iSignals)
+{
+  string l_class = identifier(iInstance) + "_If";
+  string l_defName = "?";
+  vpiHandle l_hndl = Hierarchy::Find(iInstance);
+  if(l_hndl != NULL)
+  {
+    char * l_str = Vpi::vpi_get_str(Vpi::PROPERTY::DEF_NAME, l_hndl);
+    if(l_str != NULL)
+    {
+      l_defName = l_str;
+    }
+  }
+
+  iOut << "// " << iInstance << " (module " << l_defName << ")" << endl;
+  iOut << "class " << l_class << endl;
+  iOut << "{" << endl;
+  iOut << "  // Public Properties" << endl;
+  iOut << "  public:" << endl;
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    iOut << "    static const UInt32 c_" << iSignals[ii].name << "_width = " << iSignals[ii].size << ";" << endl;
+  }
+  // Edited widths that outgrow the value type don't compile.
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    string l_type = valueType(iSignals[ii].size);
+    if(l_type != "BitVector")
+    {
+      iOut << "    static_assert(c_" << iSignals[ii].name << "_width <= 8 * sizeof(" << l_type << "), \""
+           << iSignals[ii].rtlName << " doesn't fit " << l_type << "\");" << endl;
+    }
+  }
+  iOut << endl;
+  iOut << "  // Private Members" << endl;
+  iOut << "  private:" << endl;
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    iOut << "    " << ((iSignals[ii].type == Vpi::OBJECT::INTEGER_VAR) ? "Integer" : "Logic  ")
+         << " m_" << iSignals[ii].name << ";" << endl;
+  }
+  iOut << endl;
+  iOut << "  // Constructors" << endl;
+  iOut << "  public:" << endl;
+  iOut << "    " << l_class << "(string iPath = \"" << iInstance << "\")";
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    iOut << endl << ((ii == 0) ? "      : " : "        ")
+         << "m_" << iSignals[ii].name << "(iPath + \"." << iSignals[ii].rtlName << "\")"
+         << ((ii + 1 < iSignals.size()) ? "," : "");
+  }
+  iOut << endl;
+  iOut << "    {" << endl;
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    iOut << "      checkWidth(m_" << iSignals[ii].name << ", c_" << iSignals[ii].name << "_width);" << endl;
+  }
+  iOut << "    }" << endl;
+  iOut << "    " << l_class << "(const " << l_class << " &) = delete;" << endl;
+  iOut << endl;
+  iOut << "  // Public Methods" << endl;
+  iOut << "  public:" << endl;
+  for(UInt32 ii=0; ii<iSignals.size(); ii++)
+  {
+    const Signal & l_sig = iSignals[ii];
+    string l_type = valueType(l_sig.size);
+    bool l_writable = (l_sig.direction == Vpi::DIRECTION::INPUT) || (l_sig.direction == Vpi::DIRECTION::INOUT) ||
+                      (l_sig.direction == Vpi::DIRECTION::MIXED_IO) ||
+                      ((l_sig.direction == Vpi::DIRECTION::NO_DIR) && (l_sig.type != Vpi::OBJECT::NET));
+
+    iOut << "    // " << dirName(l_sig.direction) << " [" << (l_sig.size - 1) << ":0] " << l_sig.rtlName << endl;
+    if(l_type == "BitVector")
+    {
+      iOut << "    BitVector " << l_sig.name << "_get() const { return (BitVector)m_" << l_sig.name << "; }" << endl;
+      if(l_writable)
+      {
+        iOut << "    void      " << l_sig.name << "_set(const BitVector & iVal) { checkFit(iVal, c_" << l_sig.name
+             << "_width, \"" << l_sig.rtlName << "\"); m_" << l_sig.name << " = iVal; }" << endl;
+      }
+    }
+    else if(l_type == "UInt64")
+    {
+      iOut << "    UInt64    " << l_sig.name << "_get() const { return (UInt64)m_" << l_sig.name << "; }" << endl;
+      if(l_writable)
+      {
+        iOut << "    void      " << l_sig.name << "_set(UInt64 iVal) { m_" << l_sig.name << " = fit(iVal, c_"
+             << l_sig.name << "_width, \"" << l_sig.rtlName << "\"); }" << endl;
+      }
+    }
+    else
+    {
+      iOut << "    " << l_type << string(10 - l_type.size(), ' ') << l_sig.name << "_get() const { return ("
+           << l_type << ")(UInt32)m_" << l_sig.name << "; }" << endl;
+      if(l_writable)
+      {
+        // Takes any width, a value that doesn't fit is an error rather than
+        // silently truncated by the conversion to the value type.
+        iOut << "    void      " << l_sig.name << "_set(UInt64 iVal) { m_" << l_sig.name << " = (UInt32)fit(iVal, c_"
+             << l_sig.name << "_width, \"" << l_sig.rtlName << "\"); }" << endl;
+      }
+    }
+  }
+  iOut << endl;
+  iOut << "  // Private Methods" << endl;
+  iOut << "  private:" << endl;
+  iOut << "    void checkWidth(const TypeBase & iSig, UInt32 iWidth)" << endl;
+  iOut << "    {" << endl;
+  iOut << "      if(iSig.Get_Size() != iWidth)" << endl;
+  iOut << "      {" << endl;
+  iOut << "        LOG_ERR_ENV << \"'\" << iSig.Get_NameFull() << \"' is \" << iSig.Get_Size()" << endl;
+  iOut << "                    << \" bits in the rtl but \" << iWidth << \" in the generated interface.\" << endl;" << endl;
+  iOut << "      }" << endl;
+  iOut << "    }" << endl;
+  iOut << "    static UInt64 fit(UInt64 iVal, UInt32 iWidth, const char * iName)" << endl;
+  iOut << "    {" << endl;
+  iOut << "      UInt64 l_mask = (iWidth >= 64) ? ~0ULL : ((1ULL << iWidth) - 1);" << endl;
+  iOut << "      if((iVal & ~l_mask) != 0)" << endl;
+  iOut << "      {" << endl;
+  iOut << "        LOG_ERR_ENV << \"0x\" << hex << iVal << dec << \" doesn't fit the \" << iWidth" << endl;
+  iOut << "                    << \" bits of '\" << iName << \"', the upper bits are dropped.\" << endl;" << endl;
+  iOut << "      }" << endl;
+  iOut << "      return iVal & l_mask;" << endl;
+  iOut << "    }" << endl;
+  iOut << "    static void checkFit(const BitVector & iVal, UInt32 iWidth, const char * iName)" << endl;
+  iOut << "    {" << endl;
+  iOut << "      if(iVal.Size_get() > iWidth)" << endl;
+  iOut << "      {" << endl;
+  iOut << "        LOG_ERR_ENV << iVal.Size_get() << \" bit value set to the \" << iWidth" << endl;
+  iOut << "                    << \" bits of '\" << iName << \"', the upper bits are dropped.\" << endl;" << endl;
+  iOut << "      }" << endl;
+  iOut << "    }" << endl;
+  iOut << "};" << endl;
+  iOut << endl;
+}
+string IfGen::identifier(const string & iName)
+{
+  string l_retVal;
+  for(UInt32 ii=0; ii<iName.size(); ii++)
+  {
+    char l_c = iName[ii];
+    if(isalnum((unsigned char)l_c) || (l_c == '_'))
+    {
+      l_retVal += l_c;
+    }
+    else if((l_c == '.') || (l_c == '[') || (l_c == ']'))
+    {
+      l_retVal += '_';
+    }
+    // Anything else (i.e. the '\' of an escaped name) is dropped.
+  }
+  if((l_retVal.size() == 0) || isdigit((unsigned char)l_retVal[0]))
+  {
+    l_retVal = "_" + l_retVal;
+  }
+  return l_retVal;
+}
+string IfGen::valueType(Int32 iSize)
+{
+  if(iSize <= 8)
+  {
+    return "Byte";
+  }
+  if(iSize <= 16)
+  {
+    return "UInt16";
+  }
+  if(iSize <= 32)
+  {
+    return "UInt32";
+  }
+  if(iSize <= 64)
+  {
+    return "UInt64";
+  }
+  return "BitVector";
+}
+string IfGen::dirName(Vpi::DIRECTION iDir)
+{
+  switch(iDir)
+  {
+    case Vpi::DIRECTION::INPUT:
+      return "input";
+    case Vpi::DIRECTION::OUTPUT:
+      return "output";
+    case Vpi::DIRECTION::INOUT:
+      return "inout";
+    case Vpi::DIRECTION::MIXED_IO:
+      return "mixed io";
+    default:
+      return "internal";
+  }
+}
+
@@ -0,0 +1,77 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   ifgen.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Generates a typed C++ interface header for module
+#                     instances, from the hierarchy index at end of compile.
+#                     This is a run mode: the header is written and the
+#                     simulation ends without running the environment.
+#
+#                     +ifgen=top.dut0[,top.dut1]   Instances to generate.
+#                     +ifgen_out=<file>            Default $DUMP_DIR/dut_if.h
+#
+#                     One class per instance (i.e. top_dut0_If) with:
+#                       c_<sig>_width constants (usable in static_assert,
+#                       each is asserted to fit its value type),
+#                       <sig>_get() for every signal,
+#                       <sig>_set() for inputs, inouts and internal regs.
+#                     Getters use the smallest fixed width type holding the
+#                     signal (Byte/UInt16/UInt32/UInt64), BitVector above 64.
+#                     Setters take a UInt64 (or BitVector) and report a
+#                     value wider than the signal as an error, the upper
+#                     bits are dropped.
+#                     The constructor checks each width against the rtl, so
+#                     a header older than the rtl fails when it binds.
+#
+###############################################################################
+*/
+#ifndef IFGEN_H
+#define IFGEN_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "hierarchy.h"
+#include "vpi.h"
+
+using namespace std;
+
+class IfGen
+{
+  // Nested Classes
+  private:
+  struct Signal
+  {
+    string          name;       // Leaf name, as a C++ identifier.
+    string          rtlName;    // Leaf name in the rtl.
+    Vpi::OBJECT     type;
+    Int32           size;
+    Vpi::DIRECTION  direction;
+  };
+
+  // Public Methods
+  public:
+  static bool   Requested();
+  static bool   Run();
+
+  // Private Methods
+  private:
+  static bool   getArgs(vector<string> & oInstances, string & oFile);
+  static bool   collect(const string & iInstance, vector<Signal> & oSignals);
+  static void   emitClass(ofstream & iOut, const string & iInstance, const vector<Signal> & iSignals);
+  static string identifier(const string & iName);
+  static string valueType(Int32 iSize);
+  static string dirName(Vpi::DIRECTION iDir);
+};
+
+#endif /* IFGEN_H */
+
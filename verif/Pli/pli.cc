@@ -69,20 +69,18 @@ Vpi::SCALAR_VAL Pli::GetScalar(vpiHandle iHndl)
   }
 
   // void vpi_get_value(vpiHandle iHndl, p_vpi_value oValue);
-  Vpi::p_vpi_value data = new Vpi::t_vpi_value();
-  data->format = Vpi::VALUE_FORMAT::SCALAR;
-  Vpi::vpi_get_value(iHndl, data);
-
-  retVal = data->value.scalar;
-  delete data;
+  Vpi::t_vpi_value data;
+  data.format = Vpi::VALUE_FORMAT::SCALAR;
+  Vpi::vpi_get_value(iHndl, &data);
 
+  retVal = data.value.scalar;
   return retVal;
 }
 UInt32 Pli::GetVector(vpiHandle iHndl, UInt32 iWordNb)
 {
   UInt32 retVal = 0xffffffff;
   Int32 l_size;
-  Vpi::p_vpi_value data = nullptr;
+  Vpi::t_vpi_value data;
   if(!getVectorData(iHndl, l_size, data))
   {
     return retVal;
@@ -94,32 +92,31 @@ UInt32 Pli::GetVector(vpiHandle iHndl, UInt32 iWordNb)
     LOG_ERR_ENV << "Word count is " << nbWords
                 << ", word selected is " << iWordNb << " for signal "
                 << Vpi::vpi_get_str(Vpi::PROPERTY::NAME, iHndl) << endl;
+    return retVal;
   }
 
-  retVal = data->value.vector[iWordNb].aval;
-  delete data;
+  retVal = data.value.vector[iWordNb].aval;
   return retVal;
 }
 void Pli::GetVector(vpiHandle iHndl, vector<UInt32> * oAval, vector<UInt32> * oBval)
 {
   Int32 l_size;
-  Vpi::p_vpi_value data = nullptr;
+  Vpi::t_vpi_value data;
   if(!getVectorData(iHndl, l_size, data))
   {
     return;
   }
 
   Int32 nbWords = (l_size - 1) / 32 + 1;
-  if(nbWords > (oAval->size() + 1))
+  if(nbWords > oAval->size())
   {
     LOG_ERR_ENV << "Word count is " << nbWords
                 << ", aVal vector size is " << oAval->size() << " for signal "
                 << Vpi::vpi_get_str(Vpi::PROPERTY::NAME, iHndl) << endl;
-    nbWords = oAval->size() + 1;
+    nbWords = oAval->size();
   }
 
-  ImportVector(data, nbWords, oAval, oBval);
-  delete data;
+  ImportVector(&data, nbWords, oAval, oBval);
 }
 void Pli::ImportVector(Vpi::p_vpi_value iData, Int32 iNbWords, vector<UInt32> * oAval, vector<UInt32> * oBval)
 {
@@ -132,29 +129,235 @@ void Pli::ImportVector(Vpi::p_vpi_value iData, Int32 iNbWords, vector<UInt32> *
     }
   }
 }
-void Pli::SetVector(vpiHandle iHndl, vector<UInt32> * iAval, vector<UInt32> * iBval)
+void Pli::SetVectorDelayed(VectorContext & iCtx, const UInt32 * iAval, const UInt32 * iBval, UInt64 iDelay, Vpi::DELAY_MODE iMode)
 {
-  Vpi::p_vpi_value l_data = new Vpi::t_vpi_value();
-  l_data->format = Vpi::VALUE_FORMAT::VECTOR;
-  Int32 l_size = iAval->size();
-  l_data->value.vector = new Vpi::t_vpi_vecval[l_size];
-  for(UInt32 ii=0; ii<l_size; ii++)
+  // The simulator copies the value when the event is scheduled,
+  // so the context buffer can be reused right away.
+  if(iCtx.hndl == NULL)
   {
-    l_data->value.vector[ii].aval = (*iAval)[ii];
-    if(iBval != nullptr)
+    LOG_ERR_ENV << "VectorContext was not initialized." << endl;
+    return;
+  }
+  Vpi::t_vpi_time l_time;
+  l_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  l_time.high = (UInt32)(iDelay >> 32);
+  l_time.low = (UInt32)iDelay;
+  l_time.real = 0.0;
+
+  Vpi::t_vpi_value l_data;
+  if(!packNative(iCtx, iAval[0], (iBval != nullptr) ? iBval[0] : 0, l_data))
+  {
+    Vpi::t_vpi_vecval * l_vec = iCtx.vecval.data();
+    for(UInt32 ii=0; ii<iCtx.nbWords; ii++)
     {
-      l_data->value.vector[ii].bval = (*iBval)[ii];
+      l_vec[ii].aval = iAval[ii];
+      l_vec[ii].bval = (iBval != nullptr) ? iBval[ii] : 0;
     }
-    else
+    l_data.format = Vpi::VALUE_FORMAT::VECTOR;
+    l_data.value.vector = l_vec;
+  }
+  Vpi::vpi_put_value(iCtx.hndl, &l_data, &l_time, (Int32)iMode);
+}
+void Pli::ImportValue(const VectorContext & iCtx, Vpi::p_vpi_value iData, vector<UInt32> * oAval, vector<UInt32> * oBval)
+{
+  // For value change callbacks registered with iCtx.format.
+  switch(iData->format)
+  {
+    case Vpi::VALUE_FORMAT::SCALAR:
     {
-      l_data->value.vector[ii].bval = 0;
+      UInt32 l_bval;
+      scalarToBits(iData->value.scalar, oAval->at(0), l_bval);
+      if(oBval != nullptr)
+      {
+        oBval->at(0) = l_bval;
+      }
+      break;
     }
+    default:
+      ImportVector(iData, (iCtx.nbWords < oAval->size()) ? iCtx.nbWords : oAval->size(), oAval, oBval);
+      break;
   }
+}
+Vpi::SCALAR_VAL Pli::ValueLsb(Vpi::p_vpi_value iData)
+{
+  // Bit 0 decides the edges of a vector (as for @(posedge bus) in verilog).
+  switch(iData->format)
+  {
+    case Vpi::VALUE_FORMAT::SCALAR:
+      return iData->value.scalar;
+    case Vpi::VALUE_FORMAT::INT:
+      return (iData->value.integer & 1) ? Vpi::SCALAR_VAL::ONE : Vpi::SCALAR_VAL::ZERO;
+    case Vpi::VALUE_FORMAT::VECTOR:
+      return bitsToScalar(iData->value.vector[0].aval & 1, iData->value.vector[0].bval & 1);
+    default:
+      return Vpi::SCALAR_VAL::X;
+  }
+}
+void Pli::SetVector(vpiHandle iHndl, vector<UInt32> * iAval, vector<UInt32> * iBval)
+{
+  // One-off write, prefer the VectorContext overload for anything called more than once.
+  UInt32 l_size = GetSize(iHndl);
+  if(l_size == 0)
+  {
+    return;
+  }
+  // The simulator reads as many words as the signal has, missing words are 0.
+  UInt32 nbWords = (l_size - 1) / 32 + 1;
+  Vpi::t_vpi_vecval l_stack[c_stackWords];
+  vector<Vpi::t_vpi_vecval> l_heap;
+  Vpi::t_vpi_vecval * l_vec = l_stack;
+  if(nbWords > c_stackWords)
+  {
+    l_heap.resize(nbWords);
+    l_vec = l_heap.data();
+  }
+  for(UInt32 ii=0; ii<nbWords; ii++)
+  {
+    l_vec[ii].aval = (ii < iAval->size()) ? (*iAval)[ii] : 0;
+    l_vec[ii].bval = ((iBval != nullptr) && (ii < iBval->size())) ? (*iBval)[ii] : 0;
+  }
+  Vpi::t_vpi_value l_data;
+  l_data.format = Vpi::VALUE_FORMAT::VECTOR;
+  l_data.value.vector = l_vec;
+  setVectorData(iHndl, &l_data);
+}
+bool Pli::InitVectorContext(vpiHandle iHndl, UInt32 iSize, VectorContext & oCtx)
+{
+  if(iHndl == NULL)
+  {
+    LOG_ERR_ENV << "vpiHandle was NULL." << endl;
+    return false;
+  }
+  if(iSize == 0)
+  {
+    LOG_ERR_ENV << "Vector size was invalid (" << iSize << ")." << endl;
+    return false;
+  }
+  oCtx.hndl = iHndl;
+  oCtx.size = iSize;
+  oCtx.nbWords = (iSize - 1) / 32 + 1;
+  oCtx.vecval.assign(oCtx.nbWords, Vpi::t_vpi_vecval());
+  oCtx.value.format = Vpi::VALUE_FORMAT::VECTOR;
+  oCtx.value.value.vector = oCtx.vecval.data();
+  // Strobes (valid/ready/enable) are most of the signals, skip the vector machinery for them.
+  oCtx.format = Vpi::VALUE_FORMAT::VECTOR;
+  oCtx.intWrite = false;
+  if(iSize == 1)
+  {
+    oCtx.format = Vpi::VALUE_FORMAT::SCALAR;
+  }
+  else if((iSize == 32) && (GetType(iHndl) == Vpi::OBJECT::INTEGER_VAR))
+  {
+    oCtx.intWrite = true;
+  }
+  return true;
+}
+void Pli::GetVector(VectorContext & iCtx, vector<UInt32> * oAval, vector<UInt32> * oBval)
+{
+  if(iCtx.hndl == NULL)
+  {
+    LOG_ERR_ENV << "VectorContext was not initialized." << endl;
+    return;
+  }
+  if((oAval->size() > 0) && getNative(iCtx, oAval->data(), (oBval != nullptr) ? oBval->data() : nullptr))
+  {
+    return;
+  }
+  // The simulator points value.vector at its own storage on a read.
+  iCtx.value.format = Vpi::VALUE_FORMAT::VECTOR;
+  Vpi::vpi_get_value(iCtx.hndl, &iCtx.value);
 
-  setVectorData(iHndl, l_data);
+  UInt32 nbWords = iCtx.nbWords;
+  if(nbWords > oAval->size())
+  {
+    nbWords = oAval->size();
+  }
+  ImportVector(&iCtx.value, nbWords, oAval, oBval);
+}
+void Pli::SetVector(VectorContext & iCtx, const vector<UInt32> * iAval, const vector<UInt32> * iBval)
+{
+  if(iCtx.hndl == NULL)
+  {
+    LOG_ERR_ENV << "VectorContext was not initialized." << endl;
+    return;
+  }
+  if((iAval->size() > 0) && setNative(iCtx, (*iAval)[0], ((iBval != nullptr) && (iBval->size() > 0)) ? (*iBval)[0] : 0))
+  {
+    return;
+  }
+  UInt32 nbWords = iCtx.nbWords;
+  if(nbWords > iAval->size())
+  {
+    nbWords = iAval->size();
+  }
+  Vpi::t_vpi_vecval * l_vec = iCtx.vecval.data();
+  for(UInt32 ii=0; ii<nbWords; ii++)
+  {
+    l_vec[ii].aval = (*iAval)[ii];
+    l_vec[ii].bval = (iBval != nullptr) ? (*iBval)[ii] : 0;
+  }
+  // A previous read may have left value.vector pointing at simulator storage.
+  iCtx.value.format = Vpi::VALUE_FORMAT::VECTOR;
+  iCtx.value.value.vector = l_vec;
 
-  delete[] l_data->value.vector;
-  delete l_data;
+  setVectorData(iCtx.hndl, &iCtx.value);
+}
+void Pli::GetVectorWords(VectorContext & iCtx, UInt32 * oAval, UInt32 * oBval)
+{
+  // Raw buffer version, fills exactly iCtx.nbWords words.
+  if(iCtx.hndl == NULL)
+  {
+    LOG_ERR_ENV << "VectorContext was not initialized." << endl;
+    return;
+  }
+  if(getNative(iCtx, oAval, oBval))
+  {
+    return;
+  }
+  iCtx.value.format = Vpi::VALUE_FORMAT::VECTOR;
+  Vpi::vpi_get_value(iCtx.hndl, &iCtx.value);
+  for(UInt32 ii=0; ii<iCtx.nbWords; ii++)
+  {
+    oAval[ii] = iCtx.value.value.vector[ii].aval;
+    if(oBval != nullptr)
+    {
+      oBval[ii] = iCtx.value.value.vector[ii].bval;
+    }
+  }
+}
+void Pli::SetVectorWords(VectorContext & iCtx, const UInt32 * iAval, const UInt32 * iBval)
+{
+  if(iCtx.hndl == NULL)
+  {
+    LOG_ERR_ENV << "VectorContext was not initialized." << endl;
+    return;
+  }
+  if(setNative(iCtx, iAval[0], (iBval != nullptr) ? iBval[0] : 0))
+  {
+    return;
+  }
+  Vpi::t_vpi_vecval * l_vec = iCtx.vecval.data();
+  for(UInt32 ii=0; ii<iCtx.nbWords; ii++)
+  {
+    l_vec[ii].aval = iAval[ii];
+    l_vec[ii].bval = (iBval != nullptr) ? iBval[ii] : 0;
+  }
+  iCtx.value.format = Vpi::VALUE_FORMAT::VECTOR;
+  iCtx.value.value.vector = l_vec;
+
+  setVectorData(iCtx.hndl, &iCtx.value);
+}
+Int32 Pli::GetInt(vpiHandle iHndl)
+{
+  if(iHndl == NULL)
+  {
+    LOG_ERR_ENV << "vpiHandle was NULL." << endl;
+    return 0;
+  }
+  Vpi::t_vpi_value l_data;
+  l_data.format = Vpi::VALUE_FORMAT::INT;
+  Vpi::vpi_get_value(iHndl, &l_data);
+  return l_data.value.integer;
 }
 UInt32 Pli::GetSize(vpiHandle iHndl)
 {
@@ -275,7 +478,7 @@ bool Pli::checkInvalidSize(vpiHandle iHndl, Int32 & oSize)
   }
   return true;
 }
-bool Pli::getVectorData(vpiHandle iHndl, Int32 & oSize, Vpi::p_vpi_value & oData)
+bool Pli::getVectorData(vpiHandle iHndl, Int32 & oSize, Vpi::t_vpi_value & oData)
 {
   if(iHndl == NULL)
   {
@@ -288,9 +491,8 @@ bool Pli::getVectorData(vpiHandle iHndl, Int32 & oSize, Vpi::p_vpi_value & oData
     return false;
   }
 
-  oData = new Vpi::t_vpi_value();
-  oData->format = Vpi::VALUE_FORMAT::VECTOR;
-  Vpi::vpi_get_value(iHndl, oData);
+  oData.format = Vpi::VALUE_FORMAT::VECTOR;
+  Vpi::vpi_get_value(iHndl, &oData);
   return true;
 }
 bool Pli::setVectorData(vpiHandle iHndl, Vpi::p_vpi_value iData)
@@ -304,3 +506,85 @@ bool Pli::setVectorData(vpiHandle iHndl, Vpi::p_vpi_value iData)
   Vpi::vpi_put_value(iHndl, iData, NULL, (Int32)Vpi::DELAY_MODE::NO_DELAY);
   return true;
 }
+bool Pli::getNative(VectorContext & iCtx, UInt32 * oAval, UInt32 * oBval)
+{
+  // No vpiIntVal read for intWrite contexts: integers are 4-state and
+  // vpiIntVal would read their x/z as 0, they go through the vector path.
+  Vpi::t_vpi_value l_data;
+  switch(iCtx.format)
+  {
+    case Vpi::VALUE_FORMAT::SCALAR:
+    {
+      l_data.format = Vpi::VALUE_FORMAT::SCALAR;
+      Vpi::vpi_get_value(iCtx.hndl, &l_data);
+      UInt32 l_bval;
+      scalarToBits(l_data.value.scalar, oAval[0], l_bval);
+      if(oBval != nullptr)
+      {
+        oBval[0] = l_bval;
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool Pli::setNative(VectorContext & iCtx, UInt32 iAval, UInt32 iBval)
+{
+  Vpi::t_vpi_value l_data;
+  if(!packNative(iCtx, iAval, iBval, l_data))
+  {
+    return false;
+  }
+  return setVectorData(iCtx.hndl, &l_data);
+}
+bool Pli::packNative(VectorContext & iCtx, UInt32 iAval, UInt32 iBval, Vpi::t_vpi_value & oData)
+{
+  if(iCtx.format == Vpi::VALUE_FORMAT::SCALAR)
+  {
+    oData.format = Vpi::VALUE_FORMAT::SCALAR;
+    oData.value.scalar = bitsToScalar(iAval & 1, iBval & 1);
+    return true;
+  }
+  // vpiIntVal has no x/z, let the vector path carry them.
+  if(iCtx.intWrite && (iBval == 0))
+  {
+    oData.format = Vpi::VALUE_FORMAT::INT;
+    oData.value.integer = (Int32)iAval;
+    return true;
+  }
+  return false;
+}
+void Pli::scalarToBits(Vpi::SCALAR_VAL iVal, UInt32 & oAval, UInt32 & oBval)
+{
+  // Same encoding as t_vpi_vecval.
+  switch(iVal)
+  {
+    case Vpi::SCALAR_VAL::ZERO:
+    case Vpi::SCALAR_VAL::L:
+      oAval = 0;
+      oBval = 0;
+      break;
+    case Vpi::SCALAR_VAL::ONE:
+    case Vpi::SCALAR_VAL::H:
+      oAval = 1;
+      oBval = 0;
+      break;
+    case Vpi::SCALAR_VAL::Z:
+      oAval = 0;
+      oBval = 1;
+      break;
+    default:
+      oAval = 1;
+      oBval = 1;
+      break;
+  }
+}
+Vpi::SCALAR_VAL Pli::bitsToScalar(UInt32 iAval, UInt32 iBval)
+{
+  if(iBval == 0)
+  {
+    return (iAval == 0) ? Vpi::SCALAR_VAL::ZERO : Vpi::SCALAR_VAL::ONE;
+  }
+  return (iAval == 0) ? Vpi::SCALAR_VAL::Z : Vpi::SCALAR_VAL::X;
+}
@@ -24,6 +24,34 @@
 
 class Pli
 {
+  // Nested Classes
+  public:
+  // Per-signal transport for vector reads/writes.
+  // Built once (InitVectorContext) and reused for every access so that the
+  // hot path does no heap allocation and no vpiSize query.
+  // format is the native transport picked at init (reads, value changes):
+  //   SCALAR : 1-bit signals (vpiScalarVal, no word vector).
+  //   VECTOR : everything else.
+  // intWrite : integer variables. They are 4-state (and start as x), so they
+  //            are read as vectors, but writes without x/z bits go through
+  //            vpiIntVal.
+  struct VectorContext
+  {
+    vpiHandle                   hndl;
+    UInt32                      size;
+    UInt32                      nbWords;
+    Vpi::VALUE_FORMAT           format;
+    bool                        intWrite;
+    Vpi::t_vpi_value            value;
+    vector<Vpi::t_vpi_vecval>   vecval;
+
+    VectorContext() : hndl(NULL), size(0), nbWords(0), format(Vpi::VALUE_FORMAT::VECTOR), intWrite(false) { value.format = Vpi::VALUE_FORMAT::VECTOR; value.value.vector = nullptr; }
+  };
+
+  // Constants
+  private:
+  static const UInt32 c_stackWords = 8;   // One-off writes up to 256 bits stay off the heap.
+
   // Private Members
   private:
 
@@ -39,16 +67,30 @@ class Pli
   static UInt32           GetVector(vpiHandle iHndl, UInt32 iWordNb = 0);
   static void             GetVector(vpiHandle iHndl, vector<UInt32> * oAval, vector<UInt32> * oBval = nullptr);
   static void             ImportVector(Vpi::p_vpi_value iData, Int32 iNbWords, vector<UInt32> * oAval, vector<UInt32> * oBval = nullptr);
+  static void             ImportValue(const VectorContext & iCtx, Vpi::p_vpi_value iData, vector<UInt32> * oAval, vector<UInt32> * oBval = nullptr);
+  static Vpi::SCALAR_VAL  ValueLsb(Vpi::p_vpi_value iData);
   static void             SetVector(vpiHandle iHndl, vector<UInt32> * iAval, vector<UInt32> * iBval = nullptr);
+  static bool             InitVectorContext(vpiHandle iHndl, UInt32 iSize, VectorContext & oCtx);
+  static void             GetVector(VectorContext & iCtx, vector<UInt32> * oAval, vector<UInt32> * oBval = nullptr);
+  static void             SetVector(VectorContext & iCtx, const vector<UInt32> * iAval, const vector<UInt32> * iBval = nullptr);
+  static void             GetVectorWords(VectorContext & iCtx, UInt32 * oAval, UInt32 * oBval = nullptr);
+  static void             SetVectorWords(VectorContext & iCtx, const UInt32 * iAval, const UInt32 * iBval = nullptr);
+  static void             SetVectorDelayed(VectorContext & iCtx, const UInt32 * iAval, const UInt32 * iBval, UInt64 iDelay, Vpi::DELAY_MODE iMode);
+  static Int32            GetInt(vpiHandle iHndl);
   static UInt32           GetSize(vpiHandle iHndl);
   static vector<string> * GetCommandLineArgs();
 
   // Private Methods
   private:
   static void             mergeStringCLArgs(vector<string> & ioArgs);
-  static bool             getVectorData(vpiHandle iHndl, Int32 & oSize, Vpi::p_vpi_value & oData);
+  static bool             getVectorData(vpiHandle iHndl, Int32 & oSize, Vpi::t_vpi_value & oData);
   static bool             setVectorData(vpiHandle iHndl, Vpi::p_vpi_value iData);
   static bool             checkInvalidSize(vpiHandle iHndl, Int32 & oSize);
+  static bool             getNative(VectorContext & iCtx, UInt32 * oAval, UInt32 * oBval);
+  static bool             setNative(VectorContext & iCtx, UInt32 iAval, UInt32 iBval);
+  static bool             packNative(VectorContext & iCtx, UInt32 iAval, UInt32 iBval, Vpi::t_vpi_value & oData);
+  static void             scalarToBits(Vpi::SCALAR_VAL iVal, UInt32 & oAval, UInt32 & oBval);
+  static Vpi::SCALAR_VAL  bitsToScalar(UInt32 iAval, UInt32 iBval);
 };
 
 #endif /* PLI_H */
@@ -0,0 +1,121 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   region_queue.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Logger.h"
+
+#include "region_queue.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+RegionQueue::Queue  RegionQueue::s_queues[(UInt32)REGION::COUNT];
+RegionQueue::REGION RegionQueue::s_current = RegionQueue::REGION::COUNT;
+UInt64              RegionQueue::s_seq = 0;
+UInt64              RegionQueue::s_callbacks = 0;
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+bool RegionQueue::Post(REGION iRegion, function<void()> iFn, Int32 iPriority)
+{
+  if((s_current == REGION::READ_ONLY) && (iRegion != REGION::READ_ONLY))
+  {
+    LOG_ERR_ENV << "Work can't be posted to region " << (UInt32)iRegion
+                << " from the read-only region, delay it to the next time step." << endl;
+    return false;
+  }
+  Queue & l_queue = s_queues[(UInt32)iRegion];
+  Item l_item;
+  l_item.priority = iPriority;
+  l_item.seq = s_seq++;
+  l_queue.heap.push_back(l_item);
+  // Moved in place, the callable isn't copied a second time.
+  l_queue.heap.back().fn.swap(iFn);
+  push_heap(l_queue.heap.begin(), l_queue.heap.end(), later);
+  // Stays armed while draining, the drain loop picks it up.
+  if(!l_queue.armed)
+  {
+    l_queue.armed = registerCB(iRegion);
+  }
+  return true;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool RegionQueue::registerCB(REGION iRegion)
+{
+  Vpi::t_cb_data l_cb_data;
+  Vpi::t_vpi_time l_vpi_time;
+
+  l_vpi_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  l_vpi_time.high = 0;
+  l_vpi_time.low = 0;
+  l_vpi_time.real = 0;
+
+  switch(iRegion)
+  {
+    case REGION::NBA:
+      l_cb_data.reason = Vpi::CB_REASON::READ_WRITE_SYNCH;
+      break;
+    case REGION::READ_ONLY:
+      l_cb_data.reason = Vpi::CB_REASON::READ_ONLY_SYNCH;
+      break;
+    default:
+      l_cb_data.reason = Vpi::CB_REASON::AFTER_DELAY;
+      break;
+  }
+  l_cb_data.cb_rtn = s_drainCB;
+  l_cb_data.obj = NULL;
+  l_cb_data.time = &l_vpi_time;
+  l_cb_data.value = NULL;
+  l_cb_data.index = 0;
+  l_cb_data.user_data = (char *)(uintptr_t)iRegion;
+
+  if(Vpi::vpi_register_cb(&l_cb_data) == NULL)
+  {
+    LOG_ERR_ENV << "Could not register the callback draining region " << (UInt32)iRegion << "." << endl;
+    return false;
+  }
+  s_callbacks++;
+  return true;
+}
+bool RegionQueue::later(const Item & iA, const Item & iB)
+{
+  return (iA.priority > iB.priority) || ((iA.priority == iB.priority) && (iA.seq > iB.seq));
+}
+Int32 RegionQueue::s_drainCB(Vpi::t_cb_data * iData)
+{
+  REGION l_region = (REGION)(uintptr_t)iData->user_data;
+  Queue & l_queue = s_queues[(UInt32)l_region];
+  REGION l_prev = s_current;
+  s_current = l_region;
+  while(!l_queue.heap.empty())
+  {
+    pop_heap(l_queue.heap.begin(), l_queue.heap.end(), later);
+    // Moved out first, the work may post more (and grow the heap).
+    function<void()> l_fn;
+    l_fn.swap(l_queue.heap.back().fn);
+    l_queue.heap.pop_back();
+    l_fn();
+  }
+  l_queue.armed = false;
+  s_current = l_prev;
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   region_queue.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Work deferred to a region of the current time step:
+#                       RegionQueue::Post(RegionQueue::REGION::NBA, [&]() { drive(); });
+#                       RegionQueue::Post(RegionQueue::REGION::READ_ONLY, [&]() { check(); });
+#
+#                     ACTIVE     : a zero delay callback, this time step's
+#                                  active region. Posted while the active
+#                                  queue drains, it runs in the same pass.
+#                     NBA        : cbReadWriteSynch, once the active events
+#                                  are done; where the testbench drives.
+#                     READ_ONLY  : cbReadOnlySynch, the values are final for
+#                                  the time step; where it samples and checks.
+#                                  Nothing may be driven or posted to an
+#                                  earlier region from here.
+#                     Each region runs its work by priority (lowest first),
+#                     then in posting order. A region registers one callback
+#                     when its queue goes non-empty, whatever the amount of
+#                     work, so the value change callbacks of a time step
+#                     only queue work and it runs in one batch.
+#
+###############################################################################
+*/
+#ifndef REGION_QUEUE_H
+#define REGION_QUEUE_H
+
+#include <functional>
+#include <vector>
+
+#include "Common.h"
+#include "vpi.h"
+
+using namespace std;
+
+class RegionQueue
+{
+  // Enums
+  public:
+  enum class REGION
+  {
+    ACTIVE,
+    NBA,
+    READ_ONLY,
+    COUNT
+  };
+
+  // Constants
+  public:
+  // Library work brackets the user's: samples are taken first and pending
+  // writes flushed last.
+  static const Int32  c_samplePriority = -1000000;
+  static const Int32  c_defaultPriority = 0;
+  static const Int32  c_flushPriority = 1000000;
+
+  // Nested Classes
+  private:
+  struct Item
+  {
+    Int32             priority;
+    UInt64            seq;
+    function<void()>  fn;
+  };
+  struct Queue
+  {
+    vector<Item>      heap;     // Min heap on (priority, seq).
+    bool              armed;    // A callback is registered (or draining).
+  };
+
+  // Private Members
+  private:
+  static Queue    s_queues[(UInt32)REGION::COUNT];
+  static REGION   s_current;    // Region being drained, COUNT outside of one.
+  static UInt64   s_seq;
+  static UInt64   s_callbacks;
+
+  // Public Properties (get/set)
+  public:
+  static UInt32   Pending_get(REGION iRegion)   { return (UInt32)s_queues[(UInt32)iRegion].heap.size(); }
+  static REGION   Current_get()                 { return s_current; }
+  // Simulator callbacks the queues have registered so far.
+  static UInt64   Callbacks_get()               { return s_callbacks; }
+
+  // Public Methods
+  public:
+  // False (and an error) if iRegion already passed in this time step.
+  static bool     Post(REGION iRegion, function<void()> iFn, Int32 iPriority = c_defaultPriority);
+
+  // Private Methods
+  private:
+  static bool     registerCB(REGION iRegion);
+  static bool     later(const Item & iA, const Item & iB);
+  static Int32    s_drainCB(Vpi::t_cb_data * iData);
+};
+
+#endif /* REGION_QUEUE_H */
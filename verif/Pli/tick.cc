@@ -0,0 +1,257 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   tick.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <iostream>
+
+#include "Logger.h"
+
+#include "tick.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+vector<Tick::Site *>  Tick::s_sites;
+Tick::Site *          Tick::s_current = nullptr;
+Event<void>           Tick::_s_Tick;
+
+// ============================
+// ===**  Public Methods  **===
+// ============================
+Int32 Tick::IndexOf(const string & iName)
+{
+  if(s_current == nullptr)
+  {
+    return -1;
+  }
+  for(UInt32 ii=0; ii<s_current->names.size(); ii++)
+  {
+    const string & l_name = s_current->names[ii];
+    // Full name, or its last level.
+    if((l_name == iName) ||
+       ((l_name.size() > iName.size()) &&
+        (l_name.compare(l_name.size() - iName.size(), iName.size(), iName) == 0) &&
+        (l_name[l_name.size() - iName.size() - 1] == '.')))
+    {
+      return ii;
+    }
+  }
+  return -1;
+}
+UInt32 Tick::Get(UInt32 iArg, UInt32 iWord)
+{
+  if(!checkArg(iArg))
+  {
+    return 0;
+  }
+  if(iWord >= nbWords(iArg))
+  {
+    LOG_ERR_ENV << "Word " << iWord << " is out of range for $tb_tick argument " << iArg
+                << " (" << nbWords(iArg) << " words)." << endl;
+    return 0;
+  }
+  return s_current->aval[s_current->offset[iArg] + iWord];
+}
+BitVector Tick::GetBV(UInt32 iArg)
+{
+  if(!checkArg(iArg))
+  {
+    return BitVector("tb_tick", 1);
+  }
+  BitVector l_retVal(s_current->names[iArg], s_current->xport[iArg].size, NB_STATES::FOUR_STATE);
+  UInt32 l_off = s_current->offset[iArg];
+  for(UInt32 kk=0; kk<nbWords(iArg); kk++)
+  {
+    (*l_retVal.m_aval)[kk] = s_current->aval[l_off + kk];
+    (*l_retVal.m_bval)[kk] = s_current->bval[l_off + kk];
+  }
+  return l_retVal;
+}
+void Tick::Set(UInt32 iArg, UInt64 iValue)
+{
+  BitVector l_val("tb_tick", (s_current != nullptr) && (iArg < ArgCount_get()) ? s_current->xport[iArg].size : 1,
+                  NB_STATES::FOUR_STATE);
+  l_val = iValue;
+  Set(iArg, l_val);
+}
+void Tick::Set(UInt32 iArg, const BitVector & iValue)
+{
+  if(!checkArg(iArg))
+  {
+    return;
+  }
+  if(!s_current->writable[iArg])
+  {
+    LOG_ERR_ENV << "$tb_tick argument " << iArg << " (" << s_current->names[iArg]
+                << ") is not a variable and can't be written." << endl;
+    return;
+  }
+  UInt32 l_off = s_current->offset[iArg];
+  UInt32 l_size = s_current->xport[iArg].size;
+  for(UInt32 kk=0; kk<nbWords(iArg); kk++)
+  {
+    bool l_have = (kk < iValue.m_aval->size());
+    s_current->aval[l_off + kk] = l_have ? (*iValue.m_aval)[kk] : 0;
+    s_current->bval[l_off + kk] = (l_have && (iValue.m_bval != nullptr)) ? (*iValue.m_bval)[kk] : 0;
+  }
+  if(l_size % 32 != 0)
+  {
+    UInt32 l_mask = (1u << (l_size % 32)) - 1;
+    s_current->aval[l_off + nbWords(iArg) - 1] &= l_mask;
+    s_current->bval[l_off + nbWords(iArg) - 1] &= l_mask;
+  }
+  s_current->written[iArg] = true;
+}
+Int32 Tick::tb_tick_compile(char * UNUSED(iUserData))
+{
+  vpiHandle systf_handle = Vpi::vpi_handle(Vpi::OBJECT::SYS_TF_CALL, NULL);
+  if(systf_handle == NULL)
+  {
+    cout << "Failed to get SYS_TF_CALL handle to tb_tick." << endl;
+    Pli::DollarFinish();
+    return 0;
+  }
+  // The site (and the argument handles) are kept for every later call.
+  Site * l_site = buildSite(systf_handle);
+  if(l_site == nullptr)
+  {
+    Pli::DollarFinish();
+    return 0;
+  }
+  Vpi::vpi_put_userdata(systf_handle, l_site);
+  return 0;
+}
+Int32 Tick::tb_tick(char * UNUSED(iUserData))
+{
+  vpiHandle systf_handle = Vpi::vpi_handle(Vpi::OBJECT::SYS_TF_CALL, NULL);
+  Site * l_site = (Site *)Vpi::vpi_get_userdata(systf_handle);
+  if(l_site == nullptr)
+  {
+    l_site = buildSite(systf_handle);
+    if(l_site == nullptr)
+    {
+      return 0;
+    }
+    Vpi::vpi_put_userdata(systf_handle, l_site);
+  }
+
+  for(UInt32 ii=0; ii<l_site->xport.size(); ii++)
+  {
+    Pli::GetVectorWords(l_site->xport[ii], &l_site->aval[l_site->offset[ii]], &l_site->bval[l_site->offset[ii]]);
+  }
+
+  s_current = l_site;
+  l_site->count++;
+  _s_Tick();
+
+  for(UInt32 ii=0; ii<l_site->xport.size(); ii++)
+  {
+    if(l_site->written[ii])
+    {
+      Pli::SetVectorWords(l_site->xport[ii], &l_site->aval[l_site->offset[ii]], &l_site->bval[l_site->offset[ii]]);
+      l_site->written[ii] = false;
+    }
+  }
+  s_current = nullptr;
+  return 0;
+}
+void Tick::tb_tick_register()
+{
+  Vpi::t_vpi_systf_data tf_data;
+
+  tf_data.type      = Vpi::SYS_TASK_FUNC::TASK;
+  tf_data.tfname    = "$tb_tick";
+  tf_data.calltf    = tb_tick;
+  tf_data.compiletf = tb_tick_compile;
+  tf_data.sizetf    = 0;
+
+  Vpi::vpi_register_systf(&tf_data);
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+Tick::Site * Tick::buildSite(vpiHandle iCall)
+{
+  // Walk the argument iterator once; the scan frees it at the end.
+  vpiHandle arg_iterator = Vpi::vpi_iterate(Vpi::OBJECT::ARGUMENT, iCall);
+  if(arg_iterator == NULL)
+  {
+    cout << "No arguments were passed to sysTf '$tb_tick'." << endl;
+    return nullptr;
+  }
+
+  Site * l_site = new Site();
+  l_site->call = iCall;
+  l_site->count = 0;
+  vpiHandle arg_handle;
+  while((arg_handle = Vpi::vpi_scan(arg_iterator)) != NULL)
+  {
+    Vpi::OBJECT l_type = (Vpi::OBJECT)Vpi::vpi_get(Vpi::PROPERTY::TYPE, arg_handle);
+    char * l_name = Vpi::vpi_get_str(Vpi::PROPERTY::FULL_NAME, arg_handle);
+    string l_nameStr = (l_name != NULL) ? l_name : "?";
+    if((l_type != Vpi::OBJECT::NET) && (l_type != Vpi::OBJECT::REG) &&
+       (l_type != Vpi::OBJECT::INTEGER_VAR) && (l_type != Vpi::OBJECT::PART_SELECT))
+    {
+      cout << "Argument " << l_site->names.size() << " (" << l_nameStr
+           << ") to SysTfCall '$tb_tick' is not a net, reg, integer or part select." << endl;
+      Vpi::vpi_free_object(arg_iterator);
+      delete l_site;
+      return nullptr;
+    }
+    // This runs in compiletf, before the Logger exists: errors go to cout
+    // and the size is checked here, so the Pli helpers never log.
+    Int32 l_size = Vpi::vpi_get(Vpi::PROPERTY::SIZE, arg_handle);
+    if(l_size <= 0)
+    {
+      cout << "Argument " << l_site->names.size() << " (" << l_nameStr
+           << ") to SysTfCall '$tb_tick' has an invalid size (" << l_size << ")." << endl;
+      Vpi::vpi_free_object(arg_iterator);
+      delete l_site;
+      return nullptr;
+    }
+    Pli::VectorContext l_ctx;
+    Pli::InitVectorContext(arg_handle, (UInt32)l_size, l_ctx);
+    l_site->names.push_back(l_nameStr);
+    l_site->offset.push_back(l_site->aval.size());
+    l_site->writable.push_back((l_type == Vpi::OBJECT::REG) || (l_type == Vpi::OBJECT::INTEGER_VAR));
+    l_site->written.push_back(false);
+    l_site->aval.resize(l_site->aval.size() + l_ctx.nbWords, 0);
+    l_site->bval.resize(l_site->bval.size() + l_ctx.nbWords, 0);
+    l_site->xport.push_back(l_ctx);
+  }
+  s_sites.push_back(l_site);
+  return l_site;
+}
+bool Tick::checkArg(UInt32 iArg)
+{
+  if(s_current == nullptr)
+  {
+    LOG_ERR_ENV << "$tb_tick arguments are only available during a tick." << endl;
+    return false;
+  }
+  if(iArg >= s_current->xport.size())
+  {
+    LOG_ERR_ENV << "$tb_tick has " << s_current->xport.size() << " arguments, "
+                << iArg << " is out of range." << endl;
+    return false;
+  }
+  return true;
+}
+UInt32 Tick::nbWords(UInt32 iArg)
+{
+  return s_current->xport[iArg].nbWords;
+}
+
@@ -0,0 +1,90 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   tick.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   $tb_tick(sig0, sig1, ...) system task, for a cycle based
+#                     mode with one crossing into C++ per clock:
+#                       always @(posedge clk) $tb_tick(valid, data, ready);
+#
+#                     Every call reads all of its arguments, fires _s_Tick
+#                     (agents and models run from it), then writes back the
+#                     arguments that were Set() during the tick.
+#                     The argument handles and transport contexts are built
+#                     once per call site (first call) and kept on the call
+#                     handle, so a call does no iteration or lookup.
+#                     Only variable (reg/integer) arguments can be written.
+#
+###############################################################################
+*/
+#ifndef TICK_H
+#define TICK_H
+
+#include <string>
+#include <vector>
+
+#include "BitVector.h"
+#include "Common.h"
+#include "Event.h"
+#include "pli.h"
+#include "vpi.h"
+
+using namespace std;
+
+class Tick
+{
+  // Nested Classes
+  private:
+  // One per $tb_tick call in the verilog.
+  struct Site
+  {
+    vpiHandle                   call;
+    vector<string>              names;
+    vector<Pli::VectorContext>  xport;
+    vector<UInt32>              offset;   // First word of each argument in aval/bval.
+    vector<bool>                writable;
+    vector<bool>                written;
+    vector<UInt32>              aval;
+    vector<UInt32>              bval;
+    UInt64                      count;
+  };
+
+  // Private Members
+  private:
+  static vector<Site *> s_sites;
+  static Site *         s_current;
+
+  // Public Properties (get/set)
+  public:
+  // Fired once per $tb_tick call; the accessors below refer to that call.
+  static Event<void>    _s_Tick;
+  static UInt32         ArgCount_get()    { return (s_current != nullptr) ? s_current->xport.size() : 0; }
+  static UInt64         Count_get()       { return (s_current != nullptr) ? s_current->count : 0; }
+  static UInt32         SiteCount_get()   { return s_sites.size(); }
+
+  // Public Methods
+  public:
+  static Int32          IndexOf(const string & iName);
+  static UInt32         Get(UInt32 iArg, UInt32 iWord = 0);
+  static BitVector      GetBV(UInt32 iArg);
+  static void           Set(UInt32 iArg, UInt64 iValue);
+  static void           Set(UInt32 iArg, const BitVector & iValue);
+  static Int32          tb_tick_compile(char * UNUSED(iUserData));
+  static Int32          tb_tick(char * UNUSED(iUserData));
+  static void           tb_tick_register();
+
+  // Private Methods
+  private:
+  static Site *         buildSite(vpiHandle iCall);
+  static bool           checkArg(UInt32 iArg);
+  static UInt32         nbWords(UInt32 iArg);
+};
+
+#endif /* TICK_H */
+
@@ -0,0 +1,273 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   timer_wheel.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include "Logger.h"
+
+#include "timer_wheel.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+vector<TimerWheel::Entry> TimerWheel::s_entries;
+vector<UInt32>            TimerWheel::s_free;
+UInt32                    TimerWheel::s_heads[c_levels * c_slots];
+UInt32                    TimerWheel::s_tails[c_levels * c_slots];
+UInt64                    TimerWheel::s_occupied[c_levels][c_slots / 64];
+UInt64                    TimerWheel::s_base = 0;
+UInt32                    TimerWheel::s_pending = 0;
+bool                      TimerWheel::s_dispatching = false;
+vpiHandle                 TimerWheel::s_cb = NULL;
+UInt64                    TimerWheel::s_cbTime = 0;
+UInt64                    TimerWheel::s_callbacks = 0;
+
+// =============================
+// ===** Public Properties **===
+// =============================
+UInt64 TimerWheel::Now_get()
+{
+  Vpi::t_vpi_time l_time;
+  l_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  Vpi::vpi_get_time(NULL, &l_time);
+  return ((UInt64)l_time.high << 32) | l_time.low;
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+TimerWheel::Id TimerWheel::Schedule(UInt64 iDelay, function<void()> iFn)
+{
+  if(s_entries.empty())
+  {
+    for(UInt32 ii=0; ii<c_levels * c_slots; ii++)
+    {
+      s_heads[ii] = c_nil;
+      s_tails[ii] = c_nil;
+    }
+  }
+  UInt32 l_idx;
+  if(s_free.empty())
+  {
+    l_idx = s_entries.size();
+    s_entries.push_back(Entry());
+    s_entries[l_idx].gen = 0;
+  }
+  else
+  {
+    l_idx = s_free.back();
+    s_free.pop_back();
+  }
+  UInt64 l_now = Now_get();
+  Entry & l_entry = s_entries[l_idx];
+  l_entry.deadline = l_now + iDelay;
+  l_entry.fn = iFn;
+  l_entry.gen++;
+  insert(l_idx);
+  s_pending++;
+
+  // While dispatching, the batch loop picks up what's due now and re-arms
+  // for the rest once it's done.
+  if(!s_dispatching && ((s_cb == NULL) || (l_entry.deadline < s_cbTime)))
+  {
+    arm(l_entry.deadline, l_now);
+  }
+  return ((UInt64)l_entry.gen << 32) | l_idx;
+}
+bool TimerWheel::Cancel(Id iId)
+{
+  UInt32 l_idx = (UInt32)iId;
+  if((l_idx >= s_entries.size()) || (s_entries[l_idx].gen != (UInt32)(iId >> 32)) ||
+     (s_entries[l_idx].slot == c_nil))
+  {
+    return false;
+  }
+  // The callback stays armed, it finds nothing due and re-arms for the next.
+  unlink(l_idx);
+  release(l_idx);
+  return true;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+void TimerWheel::insert(UInt32 iIdx)
+{
+  Entry & l_entry = s_entries[iIdx];
+  UInt64 l_diff = l_entry.deadline ^ s_base;
+  UInt32 l_level = (l_diff == 0) ? 0 : (63 - __builtin_clzll(l_diff)) / 8;
+  UInt32 l_slot = (UInt32)(l_entry.deadline >> (8 * l_level)) & (c_slots - 1);
+  UInt32 l_bucket = l_level * c_slots + l_slot;
+
+  l_entry.slot = l_bucket;
+  l_entry.next = c_nil;
+  l_entry.prev = s_tails[l_bucket];
+  if(l_entry.prev == c_nil)
+  {
+    s_heads[l_bucket] = iIdx;
+  }
+  else
+  {
+    s_entries[l_entry.prev].next = iIdx;
+  }
+  s_tails[l_bucket] = iIdx;
+  s_occupied[l_level][l_slot / 64] |= 1ull << (l_slot % 64);
+}
+void TimerWheel::unlink(UInt32 iIdx)
+{
+  Entry & l_entry = s_entries[iIdx];
+  UInt32 l_bucket = l_entry.slot;
+  if(l_entry.prev == c_nil)
+  {
+    s_heads[l_bucket] = l_entry.next;
+  }
+  else
+  {
+    s_entries[l_entry.prev].next = l_entry.next;
+  }
+  if(l_entry.next == c_nil)
+  {
+    s_tails[l_bucket] = l_entry.prev;
+  }
+  else
+  {
+    s_entries[l_entry.next].prev = l_entry.prev;
+  }
+  if(s_heads[l_bucket] == c_nil)
+  {
+    UInt32 l_slot = l_bucket % c_slots;
+    s_occupied[l_bucket / c_slots][l_slot / 64] &= ~(1ull << (l_slot % 64));
+  }
+  l_entry.slot = c_nil;
+}
+void TimerWheel::release(UInt32 iIdx)
+{
+  s_entries[iIdx].fn = nullptr;
+  s_free.push_back(iIdx);
+  s_pending--;
+}
+void TimerWheel::advance(UInt64 iTime)
+{
+  // Nothing is due before iTime, so only the slot iTime falls in at each
+  // level needs to move down; top down, so a timer can fall several levels.
+  s_base = iTime;
+  for(UInt32 l_level=c_levels-1; l_level>0; l_level--)
+  {
+    UInt32 l_bucket = l_level * c_slots + ((UInt32)(iTime >> (8 * l_level)) & (c_slots - 1));
+    UInt32 l_idx = s_heads[l_bucket];
+    while(l_idx != c_nil)
+    {
+      UInt32 l_next = s_entries[l_idx].next;
+      unlink(l_idx);
+      insert(l_idx);
+      l_idx = l_next;
+    }
+  }
+}
+void TimerWheel::dispatch(UInt64 iTime)
+{
+  advance(iTime);
+  s_dispatching = true;
+  UInt32 l_bucket = (UInt32)iTime & (c_slots - 1);
+  while(s_heads[l_bucket] != c_nil)
+  {
+    UInt32 l_idx = s_heads[l_bucket];
+    function<void()> l_fn;
+    l_fn.swap(s_entries[l_idx].fn);
+    unlink(l_idx);
+    release(l_idx);
+    l_fn();
+  }
+  s_dispatching = false;
+
+  UInt64 l_next;
+  if(nextDeadline(l_next))
+  {
+    arm(l_next, iTime);
+  }
+}
+bool TimerWheel::nextDeadline(UInt64 & oTime)
+{
+  for(UInt32 l_level=0; l_level<c_levels; l_level++)
+  {
+    // Level 0 holds the current slot too (zero delay), the others only later
+    // slots.
+    UInt32 l_start = ((UInt32)(s_base >> (8 * l_level)) & (c_slots - 1)) + ((l_level == 0) ? 0 : 1);
+    for(UInt32 l_word=l_start / 64; l_word<c_slots / 64; l_word++)
+    {
+      UInt64 l_bits = s_occupied[l_level][l_word];
+      if(l_word == l_start / 64)
+      {
+        l_bits &= ~0ull << (l_start % 64);
+      }
+      if(l_bits == 0)
+      {
+        continue;
+      }
+      UInt32 l_bucket = l_level * c_slots + l_word * 64 + __builtin_ctzll(l_bits);
+      // Timers of one slot share the bytes above the level, not the ones below.
+      oTime = ~0ull;
+      for(UInt32 l_idx=s_heads[l_bucket]; l_idx!=c_nil; l_idx=s_entries[l_idx].next)
+      {
+        if(s_entries[l_idx].deadline < oTime)
+        {
+          oTime = s_entries[l_idx].deadline;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+void TimerWheel::arm(UInt64 iDeadline, UInt64 iNow)
+{
+  if(s_cb != NULL)
+  {
+    Vpi::vpi_remove_cb(s_cb);
+    s_cb = NULL;
+  }
+
+  Vpi::t_cb_data l_cb_data;
+  Vpi::t_vpi_time l_vpi_time;
+  UInt64 l_delay = iDeadline - iNow;
+
+  l_vpi_time.type = Vpi::TIME_TYPE::SIM_TIME;
+  l_vpi_time.high = (UInt32)(l_delay >> 32);
+  l_vpi_time.low = (UInt32)l_delay;
+  l_vpi_time.real = 0;
+
+  l_cb_data.reason = Vpi::CB_REASON::AFTER_DELAY;
+  l_cb_data.cb_rtn = s_expireCB;
+  l_cb_data.obj = NULL;
+  l_cb_data.time = &l_vpi_time;
+  l_cb_data.value = NULL;
+  l_cb_data.index = 0;
+  l_cb_data.user_data = NULL;
+
+  s_cb = Vpi::vpi_register_cb(&l_cb_data);
+  if(s_cb == NULL)
+  {
+    LOG_ERR_ENV << "Could not register the timer wheel callback for time " << iDeadline << "." << endl;
+    return;
+  }
+  s_cbTime = iDeadline;
+  s_callbacks++;
+}
+Int32 TimerWheel::s_expireCB(Vpi::t_cb_data * UNUSED(iData))
+{
+  // Freed by the simulator once it returns.
+  s_cb = NULL;
+  dispatch(s_cbTime);
+  return 0;
+}
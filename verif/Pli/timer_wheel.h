@@ -0,0 +1,104 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   timer_wheel.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Simulation time timers sharing one simulator callback:
+#                       TimerWheel::Id l_to = TimerWheel::Schedule(500, [=]() { timeout(); });
+#                       ...
+#                       TimerWheel::Cancel(l_to);
+#
+#                     A hierarchical timer wheel: 8 levels of 256 slots, one
+#                     level per byte of the 64 bit time. A timer goes in the
+#                     level of the highest byte where its deadline differs
+#                     from the wheel's time, and moves down a level each time
+#                     the wheel reaches its slot. Schedule and Cancel are
+#                     O(1).
+#                     Only one cbAfterDelay is outstanding, for the earliest
+#                     deadline; it runs every timer due then in one batch,
+#                     in the order they were scheduled per slot.
+#
+###############################################################################
+*/
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <functional>
+#include <vector>
+
+#include "Common.h"
+#include "vpi.h"
+
+using namespace std;
+
+class TimerWheel
+{
+  // Constants
+  private:
+  static const UInt32 c_levels = 8;
+  static const UInt32 c_slots = 256;
+  static const UInt32 c_nil = 0xFFFFFFFF;
+
+  // Nested Classes
+  public:
+  // Generation in the high word, so a stale Id never cancels a reused entry.
+  typedef UInt64 Id;
+
+  private:
+  struct Entry
+  {
+    UInt64            deadline;
+    function<void()>  fn;
+    UInt32            prev;
+    UInt32            next;
+    UInt32            slot;       // level * c_slots + slot, c_nil when free.
+    UInt32            gen;
+  };
+
+  // Private Members
+  private:
+  static vector<Entry>  s_entries;
+  static vector<UInt32> s_free;
+  static UInt32         s_heads[c_levels * c_slots];
+  static UInt32         s_tails[c_levels * c_slots];
+  static UInt64         s_occupied[c_levels][c_slots / 64];
+  static UInt64         s_base;       // Time the wheel has advanced to.
+  static UInt32         s_pending;
+  static bool           s_dispatching;
+  static vpiHandle      s_cb;
+  static UInt64         s_cbTime;
+  static UInt64         s_callbacks;
+
+  // Public Properties (get/set)
+  public:
+  static UInt32         Pending_get()     { return s_pending; }
+  // Simulator callbacks the wheel has registered so far.
+  static UInt64         Callbacks_get()   { return s_callbacks; }
+  static UInt64         Now_get();
+
+  // Public Methods
+  public:
+  // iFn runs iDelay ticks from now (0: later in this time step).
+  static Id             Schedule(UInt64 iDelay, function<void()> iFn);
+  // False if the timer already ran or was cancelled.
+  static bool           Cancel(Id iId);
+
+  // Private Methods
+  private:
+  static void           insert(UInt32 iIdx);
+  static void           unlink(UInt32 iIdx);
+  static void           release(UInt32 iIdx);
+  static void           advance(UInt64 iTime);
+  static void           dispatch(UInt64 iTime);
+  static bool           nextDeadline(UInt64 & oTime);
+  static void           arm(UInt64 iDeadline, UInt64 iNow);
+  static Int32          s_expireCB(Vpi::t_cb_data * iData);
+};
+
+#endif /* TIMER_WHEEL_H */
@@ -17,10 +17,15 @@
 #include <iostream>
 
 #include "BitVector.h"
+#include "checkpoint.h"
 #include "EnvManager.h"
+#include "hierarchy.h"
+#include "ifgen.h"
 #include "Logger.h"
+#include "Objection.h"
 #include "pli.h"
 #include "TestController.h"
+#include "tick.h"
 #include "TypeBase.h"
 
 #include "vpi_entry.h"
@@ -37,6 +42,7 @@ void (*vlog_startup_routines[])() = {
   vpi_entry::StartOfSimulationCB_register,
   vpi_entry::EndOfSimulationCB_register,
   vpi_entry::tb_build_register,
+  Tick::tb_tick_register,
   0
 };
 
@@ -109,6 +115,7 @@ Int32 vpi_entry::tb_build_compile(char * UNUSED(iUserData))
     Pli::DollarFinish();
     return 0;
   }
+  return 0;
 }
 Int32 vpi_entry::tb_build(char * UNUSED(iUserData))
 {
@@ -123,6 +130,8 @@ Int32 vpi_entry::tb_build(char * UNUSED(iUserData))
   LOG_DEBUG << "m_topModule name is '" 
             << Vpi::vpi_get_str(Vpi::PROPERTY::NAME, m_topModule)
             << "'." << endl;
+  // Components are built from here, the test may end once they stop objecting.
+  Objection::EnvBuilt();
   LOG_DEBUG << "tb_build: Exit." << endl;
   return 0;
 }
@@ -142,8 +151,18 @@ void vpi_entry::tb_build_register()
 Int32 vpi_entry::EndOfCompilationCB(Vpi::t_cb_data * UNUSED(iCbData))
 {
   cout << LINE_HDR << "========= End of Compilation =========" << endl;
-  // Creating the EnvManager runs inits on the environment.
+  // Creating the EnvManager runs inits on the environment (and sets up the
+  // logger the hierarchy index logs to).
   EnvManager::Access();
+  // Index the design before the environment starts binding signals.
+  Hierarchy::Build();
+  // +ifgen only writes the interface header, the environment doesn't run.
+  if(IfGen::Requested())
+  {
+    IfGen::Run();
+    Pli::DollarFinish();
+    return 0;
+  }
   _s_EndOfCompilation();
   return 0;
 }
@@ -164,8 +183,11 @@ void vpi_entry::EndOfCompilationCB_register()
 Int32 vpi_entry::StartOfSimulationCB(Vpi::t_cb_data * UNUSED(iCbData))
 {
   LOG_DEBUG << "========= Start of Simulation =========" << endl;
+  // +checkpoint_save/+checkpoint_restore callbacks.
+  Checkpoint::Arm();
   _s_StartOfSimulation();
-  // Stub
+  // The test runs on its own thread from a zero delay callback.
+  TestController::Access().StartTest();
   return 0;
 }
 void vpi_entry::StartOfSimulationCB_register()
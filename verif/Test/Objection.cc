@@ -0,0 +1,213 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Objection.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include "Logger.h"
+#include "pli.h"
+#include "TestController.h"
+#include "WorkerPool.h"
+
+#include "Objection.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+const string          Objection::c_drainTimeArg = "drainTime";
+const string          Objection::c_timeoutArg = "timeout";
+const string          Objection::c_hangTimeoutArg = "hangTimeout";
+map<string, UInt32>   Objection::s_raised;
+UInt32                Objection::s_count = 0;
+UInt64                Objection::s_drainTime = 0;
+UInt64                Objection::s_timeout = 0;
+UInt64                Objection::s_hangTimeout = 0;
+UInt64                Objection::s_lastActivity = 0;
+bool                  Objection::s_started = false;
+bool                  Objection::s_built = false;
+bool                  Objection::s_everRaised = false;
+bool                  Objection::s_finished = false;
+bool                  Objection::s_draining = false;
+TimerWheel::Id        Objection::s_drainTimer = 0;
+
+// =============================
+// ===** Public Properties **===
+// =============================
+UInt32 Objection::Count_get(const string & iName)
+{
+  auto l_it = s_raised.find(iName);
+  return (l_it == s_raised.end()) ? 0 : l_it->second;
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+void Objection::Start()
+{
+  if(s_started)
+  {
+    return;
+  }
+  s_started = true;
+  TestController & l_ctrl = TestController::Access();
+  s_drainTime = l_ctrl.GetCmdArg_UInt64(c_drainTimeArg);
+  s_timeout = l_ctrl.GetCmdArg_UInt64(c_timeoutArg);
+  s_hangTimeout = l_ctrl.GetCmdArg_UInt64(c_hangTimeoutArg);
+  s_lastActivity = TimerWheel::Now_get();
+  LOG_MEDIUM << "Objections: drain time " << s_drainTime << ", timeout " << s_timeout
+             << ", hang timeout " << s_hangTimeout << " ticks." << endl;
+
+  if(s_timeout > 0)
+  {
+    UInt64 l_now = TimerWheel::Now_get();
+    TimerWheel::Schedule((s_timeout > l_now) ? (s_timeout - l_now) : 0, watchdog);
+  }
+  if(s_hangTimeout > 0)
+  {
+    TimerWheel::Schedule(s_hangTimeout, hangCheck);
+  }
+}
+void Objection::EnvBuilt()
+{
+  if(!s_started || s_built)
+  {
+    return;
+  }
+  s_built = true;
+  // Later in this time step, the components just built may still raise.
+  TimerWheel::Schedule(0, checkDone);
+  TimerWheel::Schedule(s_drainTime, noObjection);
+}
+void Objection::Raise(const string & iName, UInt32 iCount)
+{
+  if(s_finished)
+  {
+    return;
+  }
+  s_raised[iName] += iCount;
+  s_count += iCount;
+  s_everRaised = true;
+  Activity();
+  if(s_draining)
+  {
+    TimerWheel::Cancel(s_drainTimer);
+    s_draining = false;
+    LOG_DEBUG << "Objection raised by '" << iName << "' during the drain time." << endl;
+  }
+}
+void Objection::Drop(const string & iName, UInt32 iCount)
+{
+  if(s_finished)
+  {
+    return;
+  }
+  auto l_it = s_raised.find(iName);
+  if((l_it == s_raised.end()) || (l_it->second < iCount))
+  {
+    LOG_ERR_ENV << "'" << iName << "' dropped " << iCount << " objection(s) but only raised "
+                << ((l_it == s_raised.end()) ? 0 : l_it->second) << "." << endl;
+    return;
+  }
+  l_it->second -= iCount;
+  if(l_it->second == 0)
+  {
+    s_raised.erase(l_it);
+  }
+  s_count -= iCount;
+  Activity();
+  checkDone();
+}
+void Objection::Activity()
+{
+  s_lastActivity = TimerWheel::Now_get();
+}
+void Objection::Report()
+{
+  LOG_MSG << s_count << " objection(s) outstanding." << endl;
+  for(auto l_it = s_raised.begin(); l_it != s_raised.end(); l_it++)
+  {
+    LOG_MSG << "  '" << l_it->first << "' : " << l_it->second << endl;
+  }
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+void Objection::checkDone()
+{
+  // Nothing ever objecting (no test selected) is left to noObjection().
+  if(!s_started || !s_built || !s_everRaised || s_finished || s_draining || (s_count > 0))
+  {
+    return;
+  }
+  s_draining = true;
+  s_drainTimer = TimerWheel::Schedule(s_drainTime, drained);
+}
+void Objection::finish(const string & iReason, bool iError)
+{
+  if(s_finished)
+  {
+    return;
+  }
+  s_finished = true;
+  // What the workers still check reports before the end.
+  WorkerPool::Barrier();
+  if(iError)
+  {
+    LOG_ERR << iReason << endl;
+    Report();
+  }
+  else
+  {
+    LOG_MSG << iReason << endl;
+  }
+  Pli::DollarFinish();
+}
+void Objection::drained()
+{
+  s_draining = false;
+  if(s_count == 0)
+  {
+    finish("All objections dropped, the simulation ends.", false);
+  }
+}
+void Objection::noObjection()
+{
+  // No test selected: nothing will ever drop, end rather than run forever.
+  if(s_everRaised)
+  {
+    return;
+  }
+  finish("No objection raised by the end of the drain time, the simulation ends.", false);
+}
+void Objection::watchdog()
+{
+  finish("Watchdog: the simulation reached the " + to_string(s_timeout) + " tick timeout.", true);
+}
+void Objection::hangCheck()
+{
+  if(s_finished)
+  {
+    return;
+  }
+  UInt64 l_now = TimerWheel::Now_get();
+  if((s_count > 0) && (l_now - s_lastActivity >= s_hangTimeout))
+  {
+    finish("Hang: no objection activity for " + to_string(l_now - s_lastActivity) + " ticks.", true);
+    return;
+  }
+  // One timer for the whole run, moved to the earliest time a hang could be
+  // declared rather than rescheduled on every activity.
+  UInt64 l_idle = l_now - s_lastActivity;
+  TimerWheel::Schedule((s_count > 0) ? (s_hangTimeout - l_idle) : s_hangTimeout, hangCheck);
+}
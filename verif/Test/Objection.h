@@ -0,0 +1,105 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Objection.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Ends the simulation once nothing objects to it, as
+#                     UVM's objections do:
+#                       Objection::Raise("scoreboard");
+#                       ...   // Outstanding transactions.
+#                       Objection::Drop("scoreboard");
+#
+#                     A test raises one objection for the duration of its
+#                     Run(). Once the environment is built ($tb_build), when
+#                     the count falls to 0, the drain time runs; a raise
+#                     during it cancels it, otherwise the simulation
+#                     finishes (Pli::DollarFinish()), once the worker pool
+#                     is idle (see WorkerPool.h). A run where nothing has
+#                     raised by the drain time after $tb_build (no test
+#                     selected) finishes then. The design doesn't need a
+#                     $finish of its own; the timeout bounds every run.
+#                     Two guards end it with an error instead:
+#                       watchdog : the simulation reached the timeout.
+#                       hang     : objections are raised, but nothing raised,
+#                                  dropped or called Activity() for the hang
+#                                  timeout.
+#                     All in simulation ticks, 0 turns the feature off:
+#                       +c_args="drainTime=100 timeout=5000000 hangTimeout=20000"
+#
+###############################################################################
+*/
+#ifndef OBJECTION_H
+#define OBJECTION_H
+
+#include <map>
+#include <string>
+
+#include "Common.h"
+#include "timer_wheel.h"
+
+using namespace std;
+
+class Objection
+{
+  // Constants
+  public:
+    static const string c_drainTimeArg;
+    static const string c_timeoutArg;
+    static const string c_hangTimeoutArg;
+
+  // Private Members
+  private:
+    static map<string, UInt32>  s_raised;     // Outstanding count per name.
+    static UInt32               s_count;
+    static UInt64               s_drainTime;
+    static UInt64               s_timeout;
+    static UInt64               s_hangTimeout;
+    static UInt64               s_lastActivity;
+    static bool                 s_started;
+    static bool                 s_built;        // $tb_build ran, the end checks are on.
+    static bool                 s_everRaised;
+    static bool                 s_finished;
+    static bool                 s_draining;
+    static TimerWheel::Id       s_drainTimer;
+
+  // Public Properties
+  public:
+    static UInt32   Count_get()                     { return s_count; }
+    static UInt32   Count_get(const string & iName);
+    static bool     Finished_get()                  { return s_finished; }
+    static UInt64   DrainTime_get()                 { return s_drainTime; }
+    static void     DrainTime_set(UInt64 iTicks)    { s_drainTime = iTicks; }
+    static UInt64   Timeout_get()                   { return s_timeout; }
+    static UInt64   HangTimeout_get()               { return s_hangTimeout; }
+
+  // Public Methods
+  public:
+    // Reads the c_args and arms the guards; called once at start of simulation.
+    static void     Start();
+    // Arms the end of test check; called from $tb_build.
+    static void     EnvBuilt();
+    static void     Raise(const string & iName, UInt32 iCount = 1);
+    static void     Drop(const string & iName, UInt32 iCount = 1);
+    // Progress without a raise or drop (i.e. a transaction), keeps the hang
+    // detector quiet.
+    static void     Activity();
+    // Logs the outstanding objections.
+    static void     Report();
+
+  // Private Methods
+  private:
+    static void     checkDone();
+    static void     finish(const string & iReason, bool iError);
+    static void     drained();
+    static void     noObjection();
+    static void     watchdog();
+    static void     hangCheck();
+};
+
+#endif /* OBJECTION_H */
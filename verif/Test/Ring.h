@@ -0,0 +1,223 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Ring.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Bounded lock-free rings between OS threads (see
+#                     WorkerPool.h):
+#                       SpscRing<Txn> l_ring(1024);   // Rounded up to a power of 2.
+#                       l_ring.TryPush(l_txn);        // Producer thread.
+#                       l_ring.TryPop(l_txn);         // Consumer thread.
+#
+#                     SpscRing : one producer, one consumer. Each side owns
+#                                its index and caches the other's, so a push
+#                                or pop is a plain store and, now and then,
+#                                one shared load.
+#                     MpscRing : any number of producers, one consumer.
+#                                Producers claim a slot with a CAS, a per
+#                                slot sequence tells the consumer it's filled
+#                                (D. Vyukov's bounded queue).
+#                     Neither ever blocks or allocates once built: TryPush
+#                     returns false when full, TryPop when empty.
+#                     Pushed_get() counts every push so far; a value is
+#                     popped at the Pushed_get() it was pushed at, in order.
+#
+###############################################################################
+*/
+#ifndef RING_H
+#define RING_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "Common.h"
+
+using namespace std;
+
+// Keeps the two sides' indices on their own cache line.
+static const UInt32 c_ringCacheLine = 64;
+
+inline UInt64 RingCapacity(UInt32 iCapacity)
+{
+  UInt64 l_cap = 2;
+  while(l_cap < iCapacity)
+  {
+    l_cap <<= 1;
+  }
+  return l_cap;
+}
+
+template<typename T>
+class SpscRing
+{
+  // Private Members
+  private:
+    unique_ptr<T[]>   m_slots;
+    UInt64            m_mask;
+    char              m_pad0[c_ringCacheLine];
+    atomic<UInt64>    m_head;       // Next to pop, written by the consumer.
+    UInt64            m_tailCache;  // Consumer's view of m_tail.
+    char              m_pad1[c_ringCacheLine];
+    atomic<UInt64>    m_tail;       // Next to push, written by the producer.
+    UInt64            m_headCache;  // Producer's view of m_head.
+    char              m_pad2[c_ringCacheLine];
+
+  // Public Properties
+  public:
+    UInt64  Capacity_get() const  { return m_mask + 1; }
+    UInt64  Pushed_get() const    { return m_tail.load(memory_order_acquire); }
+    UInt64  Popped_get() const    { return m_head.load(memory_order_acquire); }
+    bool    Empty_get() const     { return Popped_get() == Pushed_get(); }
+
+  // Constructors
+  public:
+    explicit SpscRing(UInt32 iCapacity)
+      : m_slots(new T[RingCapacity(iCapacity)]), m_mask(RingCapacity(iCapacity) - 1),
+        m_head(0), m_tailCache(0), m_tail(0), m_headCache(0)
+    {
+    }
+    SpscRing(const SpscRing &) = delete;
+    void operator=(const SpscRing &) = delete;
+
+  // Public Methods
+  public:
+    // Producer side.
+    template<typename V>
+    bool TryPush(V && iValue)
+    {
+      UInt64 l_tail = m_tail.load(memory_order_relaxed);
+      if(l_tail - m_headCache > m_mask)
+      {
+        m_headCache = m_head.load(memory_order_acquire);
+        if(l_tail - m_headCache > m_mask)
+        {
+          return false;
+        }
+      }
+      m_slots[l_tail & m_mask] = std::forward<V>(iValue);
+      m_tail.store(l_tail + 1, memory_order_release);
+      return true;
+    }
+    // Consumer side.
+    bool TryPop(T & oValue)
+    {
+      UInt64 l_head = m_head.load(memory_order_relaxed);
+      if(l_head == m_tailCache)
+      {
+        m_tailCache = m_tail.load(memory_order_acquire);
+        if(l_head == m_tailCache)
+        {
+          return false;
+        }
+      }
+      oValue = std::move(m_slots[l_head & m_mask]);
+      m_head.store(l_head + 1, memory_order_release);
+      return true;
+    }
+};
+
+template<typename T>
+class MpscRing
+{
+  // Nested Classes
+  private:
+    struct Slot
+    {
+      atomic<UInt64>  seq;    // pos: free for pos, pos + 1: filled at pos.
+      T               value;
+    };
+
+  // Private Members
+  private:
+    unique_ptr<Slot[]>  m_slots;
+    UInt64              m_mask;
+    char                m_pad0[c_ringCacheLine];
+    atomic<UInt64>      m_head;   // Next to pop, written by the consumer.
+    char                m_pad1[c_ringCacheLine];
+    atomic<UInt64>      m_tail;   // Next to claim, shared by the producers.
+    char                m_pad2[c_ringCacheLine];
+
+  // Public Properties
+  public:
+    UInt64  Capacity_get() const  { return m_mask + 1; }
+    // Claimed slots, a producer may still be filling the last ones.
+    UInt64  Pushed_get() const    { return m_tail.load(memory_order_acquire); }
+    UInt64  Popped_get() const    { return m_head.load(memory_order_acquire); }
+    bool    Empty_get() const     { return Popped_get() == Pushed_get(); }
+
+  // Constructors
+  public:
+    explicit MpscRing(UInt32 iCapacity)
+      : m_slots(new Slot[RingCapacity(iCapacity)]), m_mask(RingCapacity(iCapacity) - 1),
+        m_head(0), m_tail(0)
+    {
+      for(UInt64 ii=0; ii<=m_mask; ii++)
+      {
+        m_slots[ii].seq.store(ii, memory_order_relaxed);
+      }
+    }
+    MpscRing(const MpscRing &) = delete;
+    void operator=(const MpscRing &) = delete;
+
+  // Public Methods
+  public:
+    // Any thread. oPos (if given) is the position the value went in at.
+    template<typename V>
+    bool TryPush(V && iValue, UInt64 * oPos = nullptr)
+    {
+      UInt64 l_pos = m_tail.load(memory_order_relaxed);
+      Slot * l_slot;
+      while(true)
+      {
+        l_slot = &m_slots[l_pos & m_mask];
+        Int64 l_diff = (Int64)l_slot->seq.load(memory_order_acquire) - (Int64)l_pos;
+        if(l_diff == 0)
+        {
+          if(m_tail.compare_exchange_weak(l_pos, l_pos + 1, memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        else if(l_diff < 0)
+        {
+          // The consumer hasn't freed the slot from the previous lap.
+          return false;
+        }
+        else
+        {
+          l_pos = m_tail.load(memory_order_relaxed);
+        }
+      }
+      l_slot->value = std::forward<V>(iValue);
+      l_slot->seq.store(l_pos + 1, memory_order_release);
+      if(oPos != nullptr)
+      {
+        *oPos = l_pos;
+      }
+      return true;
+    }
+    // Consumer side. False also while the next slot is claimed but not yet
+    // filled, values are popped in position order.
+    bool TryPop(T & oValue)
+    {
+      UInt64 l_head = m_head.load(memory_order_relaxed);
+      Slot & l_slot = m_slots[l_head & m_mask];
+      if(l_slot.seq.load(memory_order_acquire) != l_head + 1)
+      {
+        return false;
+      }
+      oValue = std::move(l_slot.value);
+      l_slot.seq.store(l_head + m_mask + 1, memory_order_release);
+      m_head.store(l_head + 1, memory_order_release);
+      return true;
+    }
+};
+
+#endif /* RING_H */
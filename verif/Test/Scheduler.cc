@@ -0,0 +1,237 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Scheduler.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include "Logger.h"
+
+#include "Scheduler.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+unordered_map<Process *, ProcessPtr>  Scheduler::s_live;
+vector<ProcessPtr>                    Scheduler::s_reaped;
+UInt64                                Scheduler::s_forked = 0;
+
+// =============================
+// ===**    Constructor    **===
+// =============================
+Process::Process(string iName, function<void()> iBody, UInt32 iStackSize)
+  : Thread(iName, iBody, iStackSize)
+{
+}
+
+// =============================
+// ===** Public Properties **===
+// =============================
+Process * Process::Current_get()
+{
+  return dynamic_cast<Process *>(Thread::Current_get());
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+void Process::Kill()
+{
+  // Copied, a dying child may drop the last reference to a sibling.
+  vector<ProcessPtr> l_children = m_children;
+  for(UInt32 ii=0; ii<l_children.size(); ii++)
+  {
+    l_children[ii]->Kill();
+  }
+  Thread::Kill();
+}
+void Process::Await()
+{
+  // Joined through the scheduler's reference, done processes have none.
+  auto l_it = Scheduler::s_live.find(this);
+  if(l_it == Scheduler::s_live.end())
+  {
+    return;
+  }
+  Scheduler::Join({ l_it->second }, Scheduler::JOIN::ALL);
+}
+
+// =============================
+// ===** Protected Methods **===
+// =============================
+void Process::onDone()
+{
+  for(UInt32 ii=0; ii<m_joiners.size(); ii++)
+  {
+    Scheduler::enqueue(Scheduler::REGION::ACTIVE, m_joiners[ii]);
+  }
+  m_joiners.clear();
+  Scheduler::reap(this);
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+vector<ProcessPtr> Scheduler::Fork(const vector<function<void()>> & iBodies, JOIN iJoin, string iName)
+{
+  vector<ProcessPtr> l_procs;
+  l_procs.reserve(iBodies.size());
+  for(UInt32 ii=0; ii<iBodies.size(); ii++)
+  {
+    l_procs.push_back(launch(iName + "[" + to_string(ii) + "]", iBodies[ii], Process::c_defaultStackSize));
+  }
+  Join(l_procs, iJoin);
+  return l_procs;
+}
+ProcessPtr Scheduler::Spawn(string iName, function<void()> iBody, UInt32 iStackSize)
+{
+  return launch(iName, iBody, iStackSize);
+}
+void Scheduler::Join(const vector<ProcessPtr> & iProcs, JOIN iJoin)
+{
+  if((iJoin == JOIN::NONE) || iProcs.empty())
+  {
+    return;
+  }
+  Thread * l_self = Thread::Current_get();
+  if(l_self == nullptr)
+  {
+    LOG_ERR_ENV << "Scheduler::Join() was called outside of a thread." << endl;
+    return;
+  }
+  while(true)
+  {
+    UInt32 l_done = 0;
+    for(UInt32 ii=0; ii<iProcs.size(); ii++)
+    {
+      if(iProcs[ii]->Done_get())
+      {
+        l_done++;
+      }
+    }
+    if((l_done == iProcs.size()) || ((iJoin == JOIN::ANY) && (l_done > 0)))
+    {
+      return;
+    }
+    // Whichever process ends first fires the token, the others' copies are
+    // then no-ops.
+    Thread::WakePtr l_wake = l_self->Arm();
+    for(UInt32 ii=0; ii<iProcs.size(); ii++)
+    {
+      if(!iProcs[ii]->Done_get())
+      {
+        iProcs[ii]->m_joiners.push_back(l_wake);
+      }
+    }
+    Thread::Suspend();
+  }
+}
+void Scheduler::WaitFork()
+{
+  Process * l_self = Process::Current_get();
+  if(l_self == nullptr)
+  {
+    LOG_ERR_ENV << "Scheduler::WaitFork() was called outside of a process." << endl;
+    return;
+  }
+  Join(l_self->m_children, JOIN::ALL);
+}
+void Scheduler::DisableFork()
+{
+  Process * l_self = Process::Current_get();
+  if(l_self == nullptr)
+  {
+    LOG_ERR_ENV << "Scheduler::DisableFork() was called outside of a process." << endl;
+    return;
+  }
+  vector<ProcessPtr> l_children = l_self->m_children;
+  for(UInt32 ii=0; ii<l_children.size(); ii++)
+  {
+    l_children[ii]->Kill();
+  }
+}
+void Scheduler::Sync(REGION iRegion)
+{
+  Thread * l_self = Thread::Current_get();
+  if(l_self == nullptr)
+  {
+    LOG_ERR_ENV << "Scheduler::Sync() was called outside of a thread." << endl;
+    return;
+  }
+  enqueue(iRegion, l_self->Arm());
+  Thread::Suspend();
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+ProcessPtr Scheduler::launch(string iName, function<void()> iBody, UInt32 iStackSize)
+{
+  Process * l_parent = Process::Current_get();
+  if(l_parent != nullptr)
+  {
+    iName = l_parent->Name_get() + "." + iName;
+  }
+  ProcessPtr l_proc = make_shared<Process>(iName, iBody, iStackSize);
+  if(l_parent != nullptr)
+  {
+    // Done children are dropped here, so a long running parent doesn't
+    // accumulate them.
+    vector<ProcessPtr> & l_children = l_parent->m_children;
+    UInt32 l_kept = 0;
+    for(UInt32 ii=0; ii<l_children.size(); ii++)
+    {
+      if(!l_children[ii]->Done_get())
+      {
+        l_children[l_kept++] = l_children[ii];
+      }
+    }
+    l_children.resize(l_kept);
+    l_children.push_back(l_proc);
+  }
+  s_live[l_proc.get()] = l_proc;
+  s_forked++;
+  enqueue(REGION::ACTIVE, l_proc->Arm());
+  return l_proc;
+}
+void Scheduler::enqueue(REGION iRegion, const Thread::WakePtr & iWake)
+{
+  Thread::WakePtr l_wake = iWake;
+  // The earlier regions are over once the read-only one runs, what it wakes
+  // (i.e. the joiners of a process that sampled and ended) resumes there.
+  if(RegionQueue::Current_get() == REGION::READ_ONLY)
+  {
+    iRegion = REGION::READ_ONLY;
+  }
+  RegionQueue::Post(iRegion, [l_wake]() { Thread::Fire(l_wake); });
+}
+void Scheduler::reap(Process * iProc)
+{
+  auto l_it = s_live.find(iProc);
+  if(l_it == s_live.end())
+  {
+    return;
+  }
+  // Not released yet, we may be inside one of the process' own methods;
+  // released by the next piece of work of the region.
+  if(s_reaped.empty())
+  {
+    RegionQueue::REGION l_region = RegionQueue::Current_get();
+    RegionQueue::Post((l_region == REGION::COUNT) ? REGION::ACTIVE : l_region, release);
+  }
+  s_reaped.push_back(l_it->second);
+  s_live.erase(l_it);
+}
+void Scheduler::release()
+{
+  s_reaped.clear();
+}
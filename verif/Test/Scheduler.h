@@ -0,0 +1,143 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Scheduler.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Fork/join of test processes, as SystemVerilog does it:
+#                       // fork ... join
+#                       Scheduler::Fork({ [&]() { drive(); },
+#                                         [&]() { check(); } });
+#                       // fork ... join_any, then disable fork
+#                       Scheduler::Fork({ ... }, Scheduler::JOIN::ANY);
+#                       Scheduler::DisableFork();
+#                       // fork ... join_none, then wait fork
+#                       ProcessPtr l_seq = Scheduler::Spawn("seq", [&]() { ... });
+#                       Scheduler::WaitFork();
+#
+#                     A Process is a Thread (see Thread.h) with a parent,
+#                     children and joiners. Forking doesn't register a
+#                     callback per process: new processes, and processes woken
+#                     by a join or Sync(), are posted to a region (active,
+#                     NBA, read-only) of RegionQueue, and one callback per
+#                     region and time step drains it (see region_queue.h). A suspended process
+#                     costs its object and the touched pages of its stack.
+#
+#                     Kill() kills a process and its children. A process
+#                     handle stays valid as long as it's held; the scheduler
+#                     drops its own reference once the process is done.
+#
+###############################################################################
+*/
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "region_queue.h"
+#include "Thread.h"
+
+using namespace std;
+
+class Process;
+typedef shared_ptr<Process> ProcessPtr;
+
+class Process : public Thread
+{
+  friend class Scheduler;
+
+  // Constants
+  public:
+    // Sequences are shallow, keep thousands of them cheap.
+    static const UInt32 c_defaultStackSize = 64 * 1024;
+
+  // Private Members
+  private:
+    vector<ProcessPtr>        m_children;
+    vector<Thread::WakePtr>   m_joiners;
+
+  // Public Properties
+  public:
+    const vector<ProcessPtr> & Children_get() const { return m_children; }
+    // The running process, nullptr outside of one (a plain Thread or the simulator).
+    static Process *  Current_get();
+
+  // Constructors
+  public:
+    Process(string iName, function<void()> iBody, UInt32 iStackSize = c_defaultStackSize);
+
+  // Public Methods
+  public:
+    // Kills the children, then the process.
+    void  Kill() override;
+    // Waits for the process to end.
+    void  Await();
+
+  // Protected Methods
+  protected:
+    void  onDone() override;
+};
+
+class Scheduler
+{
+  friend class Process;
+
+  // Enums
+  public:
+    enum class JOIN
+    {
+      ALL,
+      ANY,
+      NONE
+    };
+    typedef RegionQueue::REGION REGION;
+
+  // Private Members
+  private:
+    static unordered_map<Process *, ProcessPtr> s_live;
+    static vector<ProcessPtr>                   s_reaped;
+    static UInt64                               s_forked;
+
+  // Public Properties
+  public:
+    // Processes started and not yet done.
+    static UInt32 Live_get()    { return (UInt32)s_live.size(); }
+    static UInt64 Forked_get()  { return s_forked; }
+
+  // Public Methods
+  public:
+    // One child of the current process per body, named iName[n]. The children
+    // start in the active region; iJoin tells when Fork returns. Joining
+    // (ALL, ANY) needs a thread, NONE works from simulator callbacks too.
+    static vector<ProcessPtr> Fork(const vector<function<void()>> & iBodies, JOIN iJoin = JOIN::ALL,
+                                   string iName = "fork");
+    // Fork ... join_none of a single process.
+    static ProcessPtr Spawn(string iName, function<void()> iBody,
+                            UInt32 iStackSize = Process::c_defaultStackSize);
+    static void       Join(const vector<ProcessPtr> & iProcs, JOIN iJoin = JOIN::ALL);
+    // Waits for (or kills) every child of the current process.
+    static void       WaitFork();
+    static void       DisableFork();
+    // Moves the current thread to iRegion of this time step, e.g. READ_ONLY
+    // to sample values once they settled.
+    static void       Sync(REGION iRegion);
+
+  // Private Methods
+  private:
+    static ProcessPtr launch(string iName, function<void()> iBody, UInt32 iStackSize);
+    static void       enqueue(REGION iRegion, const Thread::WakePtr & iWake);
+    static void       reap(Process * iProc);
+    static void       release();
+};
+
+#endif /* SCHEDULER_H */
@@ -14,8 +14,11 @@
 ###############################################################################
 */
 
+#include "Logger.h"
+#include "Objection.h"
 #include "TestBase.h"
 #include "TestController.h"
+#include "Thread.h"
 
 // *==*==*==*==*==*==*==*==*==*==*==*==*
 // ===**      TestBase Class       **===
@@ -36,6 +39,7 @@
 TestBase::TestBase(string iTestName)
 {
   m_name = iTestName;
+  m_thread = nullptr;
   TestController::Access().RegisterTest(this);
 }
 
@@ -47,6 +51,25 @@ TestBase::TestBase(string iTestName)
 // =============================
 // ===**  Public Methods   **===
 // =============================
+void TestBase::Start()
+{
+  if(m_thread != nullptr)
+  {
+    LOG_ERR_ENV << "Test '" << m_name << "' was already started." << endl;
+    return;
+  }
+  // Raised before the thread starts, so the end of test check at time 0
+  // already sees it.
+  Objection::Raise(m_name);
+  m_thread = new Thread(m_name, [this]()
+  {
+    LOG_MSG << "Test '" << m_name << "' started." << endl;
+    Run();
+    LOG_MSG << "Test '" << m_name << "' finished." << endl;
+    Objection::Drop(m_name);
+  });
+  m_thread->Start();
+}
 
 
 // =============================
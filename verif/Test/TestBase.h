@@ -22,6 +22,8 @@
 
 using namespace std;
 
+class Thread;
+
 class TestBase
 {
   // Enums
@@ -36,10 +38,12 @@ class TestBase
   // Private Members
   private:
     string m_name;
+    Thread * m_thread;
 
   // Public Properties
   public:
     string getName() const { return m_name; }
+    Thread * Thread_get() const { return m_thread; }
 
   // Constructors
   public:
@@ -51,6 +55,10 @@ class TestBase
   // Public Methods
   public:
     virtual void Run() = 0;
+    // Runs Run() on its own thread, so it can wait on the simulation (see
+    // Thread). Run() holds an objection; the simulation finishes once it
+    // returned and every other objection dropped (see Objection).
+    void Start();
 
   // Private Methods
   private:
@@ -16,9 +16,11 @@
 
 #include "Logger.h"
 #include "Manip.h"
+#include "Objection.h"
 #include "pli.h"
 #include "Parsing.h"
 #include "TestController.h"
+#include "WorkerPool.h"
 
 using namespace std;
 using namespace Text;
@@ -131,6 +133,24 @@ void TestController::RegisterTest(TestBase * iTest)
 {
   m_testDb.AddTest(iTest);
 }
+void TestController::StartTest()
+{
+  // Ends the simulation once the test (and everything else) stops objecting.
+  Objection::Start();
+  WorkerPool::Start();
+  string l_name = GetCmdArg_string(c_testName);
+  if(l_name == "")
+  {
+    LOG_MSG << "No test was selected (+c_args=\"" << c_testName << "=<name>\")." << endl;
+    return;
+  }
+  if(m_testDb.GetTest(l_name) == nullptr)
+  {
+    return;
+  }
+  m_testDb.SetTestToRun(l_name);
+  m_testDb.GetTestToRun()->Start();
+}
 
 // =============================
 // ===**  Private Methods  **===
@@ -34,6 +34,7 @@ class TestController
   // Constants
   private:
     const string c_cArgsPrefix = "+c_args=";
+    const string c_testName = "test";       // +c_args="test=<name>"
 
   // Nested Classes
   public:
@@ -84,6 +85,7 @@ class TestController
     string GetCmdArg_string(string iName);
     
     void   RegisterTest(TestBase * iTest);
+    void   StartTest();
 
   // Private Methods
   private:
@@ -0,0 +1,350 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Thread.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+#include "Logger.h"
+#include "timer_wheel.h"
+
+#include "Thread.h"
+
+#if defined(__x86_64__)
+// Saves the callee saved registers (and the sse/x87 control words) on the
+// current stack, stores the stack pointer in *oSave, then loads iLoad and
+// pops the same frame from it.
+extern "C" void verif_thread_switch(void ** oSave, void * iLoad);
+asm(
+  ".text\n"
+  ".globl verif_thread_switch\n"
+  ".type verif_thread_switch, @function\n"
+  "verif_thread_switch:\n"
+  "  pushq %rbp\n"
+  "  pushq %rbx\n"
+  "  pushq %r12\n"
+  "  pushq %r13\n"
+  "  pushq %r14\n"
+  "  pushq %r15\n"
+  "  subq $8, %rsp\n"
+  "  stmxcsr (%rsp)\n"
+  "  fnstcw 4(%rsp)\n"
+  "  movq %rsp, (%rdi)\n"
+  "  movq %rsi, %rsp\n"
+  "  ldmxcsr (%rsp)\n"
+  "  fldcw 4(%rsp)\n"
+  "  addq $8, %rsp\n"
+  "  popq %r15\n"
+  "  popq %r14\n"
+  "  popq %r13\n"
+  "  popq %r12\n"
+  "  popq %rbx\n"
+  "  popq %rbp\n"
+  "  ret\n"
+  ".size verif_thread_switch, .-verif_thread_switch\n"
+);
+#endif
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+Thread *  Thread::s_current = nullptr;
+UInt64    Thread::s_switches = 0;
+
+// =============================
+// ===**    Constructor    **===
+// =============================
+Thread::Thread(string iName, function<void()> iBody, UInt32 iStackSize)
+{
+  m_name = iName;
+  m_body = iBody;
+  m_state = STATE::CREATED;
+  m_stack = nullptr;
+  m_stackSize = iStackSize;
+  m_context = nullptr;
+  m_callerContext = nullptr;
+  m_caller = nullptr;
+  m_killed = false;
+}
+Thread::~Thread()
+{
+  if(m_wake)
+  {
+    m_wake->thread = nullptr;
+  }
+  if(m_state == STATE::RUNNING)
+  {
+    LOG_ERR_ENV << "Thread '" << m_name << "' was destroyed while running." << endl;
+    return;
+  }
+  // A waiting thread's frames are dropped without being unwound.
+  freeContext();
+}
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+void Thread::Start()
+{
+  if(m_state != STATE::CREATED)
+  {
+    LOG_ERR_ENV << "Thread '" << m_name << "' was already started." << endl;
+    return;
+  }
+  WakePtr l_wake = Arm();
+  TimerWheel::Schedule(0, [l_wake]() { Fire(l_wake); });
+}
+void Thread::Resume()
+{
+  if((m_state == STATE::RUNNING) || (m_state == STATE::DONE))
+  {
+    LOG_ERR_ENV << "Thread '" << m_name << "' can't be resumed, it is "
+                << ((m_state == STATE::DONE) ? "done." : "already running.") << endl;
+    return;
+  }
+  if((m_state == STATE::CREATED) && !initContext())
+  {
+    return;
+  }
+  m_caller = s_current;
+  s_current = this;
+  m_state = STATE::RUNNING;
+  s_switches++;
+  swap(&m_callerContext, &m_context);
+
+  // Back when the thread waits or ends.
+  s_current = m_caller;
+  if(m_state == STATE::DONE)
+  {
+    freeContext();
+    onDone();
+  }
+}
+void Thread::Kill()
+{
+  if((m_state == STATE::DONE) || m_killed)
+  {
+    return;
+  }
+  m_killed = true;
+  if(m_wake)
+  {
+    m_wake->thread = nullptr;
+  }
+  switch(m_state)
+  {
+    case STATE::CREATED:
+      m_state = STATE::DONE;
+      LOG_DEBUG << "Thread '" << m_name << "' was killed before it ran." << endl;
+      onDone();
+      break;
+    case STATE::WAITING:
+      // Its wait throws Killed, it unwinds and comes back here done.
+      Resume();
+      break;
+    default:
+      if(s_current == this)
+      {
+        throw Killed();
+      }
+      // Further up the resume chain, it throws at its next wait.
+      break;
+  }
+}
+Thread::WakePtr Thread::Arm()
+{
+  if(m_wake)
+  {
+    m_wake->thread = nullptr;
+  }
+  m_wake = make_shared<Wake>();
+  m_wake->thread = this;
+  return m_wake;
+}
+void Thread::Fire(const WakePtr & iWake)
+{
+  Thread * l_thread = iWake->thread;
+  if(l_thread != nullptr)
+  {
+    iWake->thread = nullptr;
+    l_thread->Resume();
+  }
+}
+void Thread::Suspend()
+{
+  if(!inThread("Suspend"))
+  {
+    return;
+  }
+  Thread * l_self = s_current;
+  if(l_self->m_killed)
+  {
+    throw Killed();
+  }
+  l_self->m_state = STATE::WAITING;
+  s_switches++;
+  swap(&l_self->m_context, &l_self->m_callerContext);
+  if(l_self->m_killed)
+  {
+    throw Killed();
+  }
+}
+void Thread::WaitTime(UInt64 iTicks)
+{
+  if(!inThread("WaitTime"))
+  {
+    return;
+  }
+  WakePtr l_wake = s_current->Arm();
+  TimerWheel::Schedule(iTicks, [l_wake]() { Fire(l_wake); });
+  Suspend();
+}
+void Thread::WaitCycles(TypeBase & iClk, UInt32 iCycles)
+{
+  if(!inThread("WaitCycles") || (iCycles == 0))
+  {
+    return;
+  }
+  WakePtr l_wake = s_current->Arm();
+  iClk.WaitPosedge(iCycles, [l_wake]() { Fire(l_wake); });
+  Suspend();
+}
+void Thread::WaitCycles(Clock & iClk, UInt32 iCycles)
+{
+  if(!inThread("WaitCycles") || (iCycles == 0))
+  {
+    return;
+  }
+  WakePtr l_wake = s_current->Arm();
+  iClk.WaitCycles(iCycles, [l_wake]() { Fire(l_wake); });
+  Suspend();
+}
+void Thread::WaitEvent(Event<void> & iEvent)
+{
+  if(!inThread("WaitEvent"))
+  {
+    return;
+  }
+  // Removed once the thread is back, from inside the fire that woke it
+  // (which Event allows).
+  WakePtr l_wake = s_current->Arm();
+  Event<void>::Token l_token = iEvent += [l_wake]() { Fire(l_wake); };
+  try
+  {
+    Suspend();
+  }
+  catch(const Killed &)
+  {
+    iEvent -= l_token;
+    throw;
+  }
+  iEvent -= l_token;
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+bool Thread::initContext()
+{
+  m_stack = (Byte *)malloc(m_stackSize);
+  if(m_stack == nullptr)
+  {
+    LOG_ERR_ENV << "Could not allocate the " << m_stackSize << " byte stack of thread '" << m_name << "'." << endl;
+    return false;
+  }
+#if defined(__x86_64__)
+  // The first switch into the thread pops this frame and returns to entry()
+  // with the stack aligned as for a call.
+  UInt64 * l_top = (UInt64 *)((uintptr_t)(m_stack + m_stackSize) & ~(uintptr_t)15);
+  l_top[-1] = 0;                          // entry() never returns.
+  l_top[-2] = (UInt64)(uintptr_t)&Thread::entry;
+  for(Int32 ii=3; ii<=8; ii++)
+  {
+    l_top[-ii] = 0;                       // rbp, rbx, r12-r15
+  }
+  l_top[-9] = 0x0000037F00001F80ull;      // Default fpu control word and mxcsr.
+  m_context = &l_top[-9];
+#else
+  ucontext_t * l_ctx = new ucontext_t();
+  getcontext(l_ctx);
+  l_ctx->uc_stack.ss_sp = m_stack;
+  l_ctx->uc_stack.ss_size = m_stackSize;
+  l_ctx->uc_link = nullptr;
+  makecontext(l_ctx, &Thread::entry, 0);
+  m_context = l_ctx;
+  m_callerContext = new ucontext_t();
+#endif
+  return true;
+}
+void Thread::freeContext()
+{
+#if !defined(__x86_64__)
+  delete (ucontext_t *)m_context;
+  delete (ucontext_t *)m_callerContext;
+  m_callerContext = nullptr;
+#endif
+  m_context = nullptr;
+  free(m_stack);
+  m_stack = nullptr;
+}
+void Thread::swap(void ** oSave, void ** iLoad)
+{
+#if defined(__x86_64__)
+  verif_thread_switch(oSave, *iLoad);
+#else
+  swapcontext((ucontext_t *)*oSave, (ucontext_t *)*iLoad);
+#endif
+}
+void Thread::entry()
+{
+  Thread * l_self = s_current;
+  try
+  {
+    l_self->m_body();
+    LOG_DEBUG << "Thread '" << l_self->m_name << "' is done." << endl;
+  }
+  catch(const Killed &)
+  {
+    LOG_DEBUG << "Thread '" << l_self->m_name << "' was killed." << endl;
+  }
+  // Nothing may unwind past the entry point of the stack, the thread ends.
+  catch(exception & iExc)
+  {
+    LOG_ERR << "Thread '" << l_self->m_name << "' threw: " << iExc.what() << endl;
+  }
+  catch(...)
+  {
+    LOG_ERR << "Thread '" << l_self->m_name << "' threw an unknown exception." << endl;
+  }
+  l_self->m_state = STATE::DONE;
+  // Never comes back, Resume() frees the stack.
+  swap(&l_self->m_context, &l_self->m_callerContext);
+}
+bool Thread::inThread(const char * iWait)
+{
+  if(s_current == nullptr)
+  {
+    LOG_ERR_ENV << "Thread::" << iWait << "() was called outside of a thread." << endl;
+    return false;
+  }
+  return true;
+}
+
@@ -0,0 +1,151 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   Thread.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   Cooperative thread of test code, so a test's Run() can
+#                     wait on the simulation without returning:
+#                       void Run()
+#                       {
+#                         Thread::WaitCycles(m_clk, 10);
+#                         m_data = 0x55;
+#                         Thread::WaitTime(100);
+#                         Thread::WaitEvent(m_mon._Done);
+#                       }
+#
+#                     Every thread has its own stack (a fiber); a wait
+#                     hands a wake up to the timer wheel, a clock or an event
+#                     and switches back to the simulator. There are no OS threads and no
+#                     semaphores, the simulator and the threads share one OS
+#                     thread and a switch only saves the callee saved
+#                     registers (x86_64; ucontext elsewhere).
+#                     Waits may only be called from inside a thread.
+#
+#                     Every wait arms a Wake token; whatever ends the wait
+#                     fires it once. Kill() disarms it, so a stale callback
+#                     or event never resumes a killed (or reused) thread.
+#                     A killed thread unwinds from its wait by throwing
+#                     Thread::Killed, don't swallow it with catch(...).
+#                     Any other exception out of the body is logged as an
+#                     error and ends the thread.
+#
+###############################################################################
+*/
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "Common.h"
+#include "Event.h"
+#include "TypeBase.h"
+
+using namespace std;
+
+class Thread
+{
+  // Enums
+  public:
+    enum class STATE
+    {
+      CREATED,
+      RUNNING,
+      WAITING,
+      DONE
+    };
+
+  // Constants
+  public:
+    static const UInt32 c_defaultStackSize = 256 * 1024;
+
+  // Nested Classes
+  public:
+    // Resumes its thread once. Disarmed (nullptr) when fired, when the thread
+    // arms another wait, is killed or is destroyed.
+    struct Wake
+    {
+      Thread * thread;
+    };
+    typedef shared_ptr<Wake> WakePtr;
+    // Thrown from the wait of a killed thread, caught where the thread started.
+    struct Killed
+    {
+    };
+
+  // Private Members
+  private:
+    string            m_name;
+    function<void()>  m_body;
+    STATE             m_state;
+    Byte *            m_stack;
+    UInt32            m_stackSize;
+    void *            m_context;        // Of the thread while it's not running.
+    void *            m_callerContext;  // Of whoever resumed it.
+    Thread *          m_caller;
+    WakePtr           m_wake;
+    bool              m_killed;
+    static Thread *   s_current;
+    static UInt64     s_switches;
+
+  // Public Properties
+  public:
+    string          Name_get() const      { return m_name; }
+    STATE           State_get() const     { return m_state; }
+    bool            Done_get() const      { return m_state == STATE::DONE; }
+    bool            Killed_get() const    { return m_killed; }
+    // The running thread, nullptr when the simulator is running.
+    static Thread * Current_get()         { return s_current; }
+    static UInt64   Switches_get()        { return s_switches; }
+
+  // Constructors
+  public:
+    Thread(string iName, function<void()> iBody, UInt32 iStackSize = c_defaultStackSize);
+    virtual ~Thread();
+    Thread(const Thread &) = delete;
+    void operator=(const Thread &) = delete;
+
+  // Public Methods
+  public:
+    // Runs the thread from a zero delay timer (the active region of the
+    // current time step).
+    void          Start();
+    // Runs the thread until it waits or ends.
+    void          Resume();
+    // Ends the thread at its wait (now if it is waiting, when it next waits
+    // if it is running). A thread that never ran just ends.
+    virtual void  Kill();
+    // Token for the thread's next wait, hand it to whatever ends the wait.
+    WakePtr       Arm();
+    static void   Fire(const WakePtr & iWake);
+    // From inside a thread: switch back to whoever resumed it.
+    static void   Suspend();
+    static void   WaitTime(UInt64 iTicks);
+    static void   WaitCycles(TypeBase & iClk, UInt32 iCycles = 1);
+    static void   WaitCycles(Clock & iClk, UInt32 iCycles = 1);
+    // iEvent must outlive the wait, the delegate is removed when it ends.
+    static void   WaitEvent(Event<void> & iEvent);
+
+  // Private Methods
+  private:
+    bool          initContext();
+    void          freeContext();
+    static void   swap(void ** oSave, void ** iLoad);
+    static void   entry();
+    static bool   inThread(const char * iWait);
+
+  // Protected Methods
+  protected:
+    // Called once the thread is done (ended, or killed).
+    virtual void  onDone() {}
+};
+
+#endif /* THREAD_H */
+
@@ -0,0 +1,383 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   WorkerPool.cc 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   
+#
+###############################################################################
+*/
+
+#include <algorithm>
+#include <chrono>
+
+#include "Logger.h"
+#include "TestController.h"
+#include "vpi_entry.h"
+
+#include "WorkerPool.h"
+
+// ====================================
+// ===**     Static Members       **===
+// ====================================
+const string                  WorkerPool::c_workersArg = "workers";
+vector<WorkerPool::Worker *>  WorkerPool::s_workers;
+vector<WorkerChannelBase *>   WorkerPool::s_channels;
+MpscRing<WorkerPool::Job>     WorkerPool::s_toSim(WorkerPool::c_toSimSize);
+UInt64                        WorkerPool::s_toSimDone = 0;
+atomic<bool>                  WorkerPool::s_stop(false);
+bool                          WorkerPool::s_started = false;
+bool                          WorkerPool::s_stopped = false;
+thread::id                    WorkerPool::s_simThread;
+UInt64                        WorkerPool::s_stalls = 0;
+
+// =============================
+// ===**  Public Methods   **===
+// =============================
+void WorkerPool::Start()
+{
+  if(s_started)
+  {
+    return;
+  }
+  Start(TestController::Access().GetCmdArg_UInt32(c_workersArg));
+}
+void WorkerPool::Start(UInt32 iWorkers)
+{
+  if(s_started)
+  {
+    LOG_WRN_ENV << "The worker pool was already started with " << s_workers.size() << " worker(s)." << endl;
+    return;
+  }
+  s_started = true;
+  s_simThread = this_thread::get_id();
+  for(UInt32 ii=0; ii<iWorkers; ii++)
+  {
+    Worker * l_worker = new Worker();
+    l_worker->osThread = thread(run, l_worker);
+    s_workers.push_back(l_worker);
+  }
+  if(iWorkers > 0)
+  {
+    vpi_entry::_s_EndOfSimulation += Stop;
+  }
+  LOG_MEDIUM << "Worker pool: " << iWorkers << " worker thread(s)"
+             << ((iWorkers == 0) ? ", the work runs inline." : ".") << endl;
+}
+void WorkerPool::Stop()
+{
+  if(!s_started || s_stopped)
+  {
+    return;
+  }
+  Barrier();
+  s_stopped = true;
+  s_stop.store(true, memory_order_release);
+  for(UInt32 ii=0; ii<s_workers.size(); ii++)
+  {
+    wake(s_workers[ii]);
+  }
+  for(UInt32 ii=0; ii<s_workers.size(); ii++)
+  {
+    s_workers[ii]->osThread.join();
+  }
+  // The workers themselves stay, channels still point to them.
+}
+void WorkerPool::Post(UInt32 iLane, Job iJob)
+{
+  Worker * l_worker = lane(iLane);
+  if(l_worker == nullptr)
+  {
+    runJob(iJob);
+    return;
+  }
+  postTo(l_worker, std::move(iJob));
+}
+void WorkerPool::ToSim(Job iJob)
+{
+  if(!s_started || (this_thread::get_id() == s_simThread))
+  {
+    iJob();
+    return;
+  }
+  // Emptied by the simulator thread as it pushes, polls or waits.
+  while(!s_toSim.TryPush(std::move(iJob)))
+  {
+    this_thread::yield();
+  }
+}
+void WorkerPool::Poll()
+{
+  Job l_job;
+  while(s_toSim.TryPop(l_job))
+  {
+    l_job();
+    l_job = nullptr;
+    s_toSimDone++;
+  }
+}
+void WorkerPool::Barrier()
+{
+  if(s_workers.empty() || s_stopped)
+  {
+    return;
+  }
+  while(!idle())
+  {
+    backoff();
+  }
+}
+
+// =============================
+// ===**  Private Methods  **===
+// =============================
+WorkerPool::Worker * WorkerPool::lane(UInt32 iLane)
+{
+  if(!s_started)
+  {
+    Start();
+  }
+  if(s_workers.empty() || s_stopped)
+  {
+    return nullptr;
+  }
+  return s_workers[iLane % s_workers.size()];
+}
+UInt64 WorkerPool::postTo(Worker * iWorker, Job iJob)
+{
+  bool l_simThread = (this_thread::get_id() == s_simThread);
+  UInt64 l_pos;
+  while(!iWorker->inbox.TryPush(std::move(iJob), &l_pos))
+  {
+    if(l_simThread)
+    {
+      s_stalls++;
+      backoff();
+    }
+    else
+    {
+      this_thread::yield();
+    }
+  }
+  wake(iWorker);
+  if(l_simThread)
+  {
+    Poll();
+  }
+  return l_pos;
+}
+void WorkerPool::wake(Worker * iWorker)
+{
+  // Pairs with the fence of a worker going to sleep: either it sees the
+  // push, or we see it sleeping.
+  atomic_thread_fence(memory_order_seq_cst);
+  if(iWorker->sleeping.load(memory_order_relaxed))
+  {
+    lock_guard<mutex> l_lock(iWorker->sleepLock);
+    iWorker->wakeUp.notify_one();
+  }
+}
+void WorkerPool::backoff()
+{
+  // A worker may be waiting for room to hand back its results.
+  Poll();
+  this_thread::yield();
+}
+bool WorkerPool::idle()
+{
+  // Everything done before everything pushed: a job pushes what it posts
+  // before it's counted done, so equal sums mean nothing is left anywhere.
+  UInt64 l_done = 0;
+  for(UInt32 ii=0; ii<s_workers.size(); ii++)
+  {
+    l_done += s_workers[ii]->done.load(memory_order_acquire);
+  }
+  for(UInt32 ii=0; ii<s_channels.size(); ii++)
+  {
+    l_done += s_channels[ii]->m_done.load(memory_order_acquire);
+  }
+  l_done += s_toSimDone;
+  UInt64 l_pushed = 0;
+  for(UInt32 ii=0; ii<s_workers.size(); ii++)
+  {
+    l_pushed += s_workers[ii]->inbox.Pushed_get();
+  }
+  for(UInt32 ii=0; ii<s_channels.size(); ii++)
+  {
+    l_pushed += s_channels[ii]->pushed_get();
+  }
+  l_pushed += s_toSim.Pushed_get();
+  return l_done == l_pushed;
+}
+bool WorkerPool::work(Worker * iWorker)
+{
+  bool l_any = false;
+  Job l_job;
+  for(UInt32 ii=0; (ii < c_batch) && iWorker->inbox.TryPop(l_job); ii++)
+  {
+    runJob(l_job);
+    l_job = nullptr;
+    iWorker->done.store(iWorker->done.load(memory_order_relaxed) + 1, memory_order_release);
+    l_any = true;
+  }
+  for(UInt32 ii=0; ii<iWorker->channels.size(); ii++)
+  {
+    if(iWorker->channels[ii]->poll(c_batch) > 0)
+    {
+      l_any = true;
+    }
+  }
+  return l_any;
+}
+bool WorkerPool::pending(Worker * iWorker)
+{
+  if(!iWorker->inbox.Empty_get())
+  {
+    return true;
+  }
+  for(UInt32 ii=0; ii<iWorker->channels.size(); ii++)
+  {
+    WorkerChannelBase * l_channel = iWorker->channels[ii];
+    if(l_channel->m_done.load(memory_order_relaxed) != l_channel->pushed_get())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+void WorkerPool::run(Worker * iWorker)
+{
+  UInt32 l_idle = 0;
+  while(true)
+  {
+    if(work(iWorker))
+    {
+      l_idle = 0;
+      continue;
+    }
+    if(s_stop.load(memory_order_acquire))
+    {
+      return;
+    }
+    if(++l_idle < c_spins)
+    {
+      this_thread::yield();
+      continue;
+    }
+    unique_lock<mutex> l_lock(iWorker->sleepLock);
+    iWorker->sleeping.store(true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if(!pending(iWorker) && !s_stop.load(memory_order_acquire))
+    {
+      // Timed, in case a wake up slips between the check and the wait.
+      iWorker->wakeUp.wait_for(l_lock, chrono::milliseconds(1));
+    }
+    iWorker->sleeping.store(false, memory_order_relaxed);
+    l_idle = 0;
+  }
+}
+void WorkerPool::runJob(Job & ioJob)
+{
+  try
+  {
+    ioJob();
+  }
+  catch(exception & iExc)
+  {
+    failed("job", iExc.what());
+  }
+  catch(...)
+  {
+    failed("job", "unknown exception");
+  }
+}
+void WorkerPool::failed(const string & iWhere, const char * iWhat)
+{
+  string l_what = iWhat;
+  ToSim([iWhere, l_what]()
+  {
+    LOG_ERR << "Worker pool " << iWhere << " threw: " << l_what << endl;
+  });
+}
+
+// *==*==*==*==*==*==*==*==*==*==*==*==*
+// ===**  WorkerChannelBase Class  **===
+// *==*==*==*==*==*==*==*==*==*==*==*==*
+
+// =============================
+// ===**    Constructor    **===
+// =============================
+WorkerChannelBase::WorkerChannelBase(UInt32 iLane)
+  : m_lane(iLane), m_attached(false), m_worker(nullptr), m_done(0)
+{
+}
+
+// =============================
+// ===** Protected Methods **===
+// =============================
+bool WorkerChannelBase::attach()
+{
+  if(m_attached)
+  {
+    return (m_worker != nullptr) && !WorkerPool::s_stopped;
+  }
+  m_attached = true;
+  m_worker = WorkerPool::lane(m_lane);
+  if(m_worker == nullptr)
+  {
+    return false;
+  }
+  WorkerPool::s_channels.push_back(this);
+  WorkerPool::Worker * l_worker = m_worker;
+  WorkerPool::postTo(l_worker, [this, l_worker]() { l_worker->channels.push_back(this); });
+  return true;
+}
+void WorkerChannelBase::detach()
+{
+  if(m_worker == nullptr)
+  {
+    return;
+  }
+  WorkerPool::Worker * l_worker = m_worker;
+  m_worker = nullptr;
+  while(m_done.load(memory_order_acquire) != pushed_get())
+  {
+    WorkerPool::backoff();
+  }
+  auto & l_channels = WorkerPool::s_channels;
+  l_channels.erase(remove(l_channels.begin(), l_channels.end(), this), l_channels.end());
+  if(WorkerPool::s_stopped)
+  {
+    return;
+  }
+  UInt64 l_pos = WorkerPool::postTo(l_worker, [this, l_worker]()
+  {
+    auto & l_list = l_worker->channels;
+    l_list.erase(remove(l_list.begin(), l_list.end(), this), l_list.end());
+  });
+  // The worker may be polling the channel until it gets there.
+  while(l_worker->done.load(memory_order_acquire) <= l_pos)
+  {
+    WorkerPool::backoff();
+  }
+}
+void WorkerChannelBase::pushed()
+{
+  WorkerPool::wake(m_worker);
+  WorkerPool::Poll();
+}
+void WorkerChannelBase::full()
+{
+  WorkerPool::s_stalls++;
+  WorkerPool::backoff();
+}
+void WorkerChannelBase::failed(const char * iWhat)
+{
+  WorkerPool::failed("channel of lane " + to_string(m_lane), iWhat);
+}
@@ -0,0 +1,271 @@
+/*
+###############################################################################
+#   Licensing information found at: 
+#     https://github.com/matthamptonasic/Hardware/
+#   In file LICENSING.md
+###############################################################################
+#
+#   File          :   WorkerPool.h 
+#   Creator       :   Matt Hampton (matthamptonasic@gmail.com)
+#   Owner         :   Matt Hampton (matthamptonasic@gmail.com)
+#   Creation Date :   10/19/26
+#   Description   :   OS worker threads for the work that doesn't need the
+#                     simulator (reference models, scoreboard compares,
+#                     coverage), so it runs beside the simulation:
+#                       // A monitor hands its transactions to lane 0.
+#                       WorkerChannel<Txn> m_toModel(0, [&](Txn & ioTxn) { m_model.Check(ioTxn); });
+#                       m_toModel.Push(l_txn);
+#                       // One off work, and the results back on the simulator thread.
+#                       WorkerPool::Post(1, [=]() { if(!ok()) { WorkerPool::ToSim([]() { LOG_ERR << ...; }); } });
+#                       WorkerPool::Barrier();    // Everything pushed so far is done.
+#
+#                     Work is keyed by lane, each lane maps to one worker, so
+#                     a lane runs in order (one lane per scoreboard keeps its
+#                     transactions in order) and lanes run in parallel.
+#                     A worker takes posted jobs from an MPSC ring and the
+#                     transactions of its channels from one SPSC ring per
+#                     channel (see Ring.h): pushing never locks, it only
+#                     waits (and counts a stall) while the ring is full.
+#                     Idle workers sleep; a push wakes them.
+#                     Jobs run off the simulator thread: they must not use
+#                     the VPI, signals, the Logger or anything the
+#                     simulation touches; they hand it back with ToSim(),
+#                     which runs on the simulator thread at the next
+#                     Push/Post, Poll() or Barrier().
+#                     Barrier() waits until every job and transaction, and
+#                     everything they posted, is done. The objections call
+#                     it before the simulation ends, the end of simulation
+#                     stops the workers.
+#                       +c_args="workers=4"   // 0 (default): run inline.
+#
+###############################################################################
+*/
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common.h"
+#include "Ring.h"
+
+using namespace std;
+
+class WorkerChannelBase;
+
+class WorkerPool
+{
+  friend class WorkerChannelBase;
+
+  // Constants
+  public:
+    static const string c_workersArg;
+    static const UInt32 c_inboxSize = 4096;
+    static const UInt32 c_toSimSize = 4096;
+
+  private:
+    static const UInt32 c_batch = 64;     // Per queue, before looking at the next.
+    static const UInt32 c_spins = 256;    // Empty polls before sleeping.
+
+  // Nested Classes
+  public:
+    typedef function<void()> Job;
+
+  private:
+    struct Worker
+    {
+      thread                      osThread;
+      MpscRing<Job>               inbox;
+      atomic<UInt64>              done;       // Inbox jobs run.
+      vector<WorkerChannelBase *> channels;   // Only the worker touches it.
+      mutex                       sleepLock;
+      condition_variable          wakeUp;
+      atomic<bool>                sleeping;
+
+      Worker() : inbox(c_inboxSize), done(0), sleeping(false) {}
+    };
+
+  // Private Members
+  private:
+    static vector<Worker *>             s_workers;
+    static vector<WorkerChannelBase *>  s_channels;
+    static MpscRing<Job>                s_toSim;
+    static UInt64                       s_toSimDone;
+    static atomic<bool>                 s_stop;
+    static bool                         s_started;
+    static bool                         s_stopped;
+    static thread::id                   s_simThread;
+    static UInt64                       s_stalls;
+
+  // Public Properties
+  public:
+    // 0 when everything runs inline on the simulator thread.
+    static UInt32 Workers_get()   { return (UInt32)s_workers.size(); }
+    // Pushes from the simulator thread that found their ring full.
+    static UInt64 Stalls_get()    { return s_stalls; }
+
+  // Public Methods
+  public:
+    // Starts c_workersArg workers; called once at start of simulation.
+    static void   Start();
+    static void   Start(UInt32 iWorkers);
+    // Barrier(), then joins the workers. Work posted later runs inline.
+    static void   Stop();
+    // iJob runs on the worker of iLane, after what the lane was given before.
+    static void   Post(UInt32 iLane, Job iJob);
+    // iJob runs on the simulator thread (right away if called from it).
+    static void   ToSim(Job iJob);
+    // Runs what the workers handed back so far (simulator thread).
+    static void   Poll();
+    // Waits until the workers are idle and everything they handed back ran
+    // (simulator thread).
+    static void   Barrier();
+
+  // Private Methods
+  private:
+    static Worker * lane(UInt32 iLane);
+    static UInt64   postTo(Worker * iWorker, Job iJob);
+    static void     wake(Worker * iWorker);
+    static void     backoff();
+    static bool     idle();
+    static bool     work(Worker * iWorker);
+    static bool     pending(Worker * iWorker);
+    static void     run(Worker * iWorker);
+    static void     runJob(Job & ioJob);
+    static void     failed(const string & iWhere, const char * iWhat);
+};
+
+// The part of a channel the pool sees, see WorkerChannel.
+class WorkerChannelBase
+{
+  friend class WorkerPool;
+
+  // Private Members
+  private:
+    UInt32                m_lane;
+    bool                  m_attached;
+    WorkerPool::Worker *  m_worker;   // nullptr when running inline.
+
+  protected:
+    atomic<UInt64>        m_done;     // Transactions consumed.
+
+  // Constructors
+  protected:
+    explicit WorkerChannelBase(UInt32 iLane);
+    WorkerChannelBase(const WorkerChannelBase &) = delete;
+    void operator=(const WorkerChannelBase &) = delete;
+    virtual ~WorkerChannelBase() {}
+
+  // Protected Methods
+  protected:
+    // False when the pool runs inline. On the first push, once the channel
+    // is fully built, so the worker never sees it half made.
+    bool            attach();
+    // Waits for the pushed transactions, then takes the channel from its
+    // worker.
+    void            detach();
+    void            pushed();
+    void            full();
+    // Reports an exception of iFn on the simulator thread.
+    void            failed(const char * iWhat);
+    // Worker side: consumes up to iMax transactions, returns how many.
+    virtual UInt32  poll(UInt32 iMax) = 0;
+    virtual UInt64  pushed_get() const = 0;
+};
+
+// Transactions of type T from the simulator thread to iFn on the worker of
+// iLane. Push() only from the simulator thread.
+template<typename T>
+class WorkerChannel : public WorkerChannelBase
+{
+  // Constants
+  public:
+    static const UInt32 c_defaultSize = 1024;
+
+  // Private Members
+  private:
+    SpscRing<T>         m_ring;
+    function<void(T &)> m_fn;
+
+  // Public Properties
+  public:
+    UInt64  Pushed_get() const  { return m_ring.Pushed_get(); }
+    UInt64  Done_get() const    { return m_done.load(memory_order_acquire); }
+
+  // Constructors
+  public:
+    WorkerChannel(UInt32 iLane, function<void(T &)> iFn, UInt32 iCapacity = c_defaultSize)
+      : WorkerChannelBase(iLane), m_ring(iCapacity), m_fn(iFn)
+    {
+    }
+    // Here rather than in the base, the worker may still be calling poll().
+    ~WorkerChannel()
+    {
+      detach();
+    }
+
+  // Public Methods
+  public:
+    template<typename V>
+    void Push(V && iValue)
+    {
+      if(!attach())
+      {
+        T l_value = std::forward<V>(iValue);
+        consume(l_value);
+        return;
+      }
+      // Only moved from once it's in.
+      while(!m_ring.TryPush(std::forward<V>(iValue)))
+      {
+        full();
+      }
+      pushed();
+    }
+
+  // Protected Methods
+  protected:
+    UInt32 poll(UInt32 iMax) override
+    {
+      T l_value;
+      UInt32 l_count = 0;
+      while((l_count < iMax) && m_ring.TryPop(l_value))
+      {
+        consume(l_value);
+        l_count++;
+        m_done.store(m_done.load(memory_order_relaxed) + 1, memory_order_release);
+      }
+      return l_count;
+    }
+    UInt64 pushed_get() const override
+    {
+      return m_ring.Pushed_get();
+    }
+
+  // Private Methods
+  private:
+    // A throwing transaction is reported and counted consumed all the same.
+    void consume(T & ioValue)
+    {
+      try
+      {
+        m_fn(ioValue);
+      }
+      catch(exception & iExc)
+      {
+        failed(iExc.what());
+      }
+      catch(...)
+      {
+        failed("unknown exception");
+      }
+    }
+};
+
+#endif /* WORKERPOOL_H */